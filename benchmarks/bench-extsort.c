@@ -0,0 +1,93 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "bench.h"
+
+#define IN_PATH  "bench-extsort-in.bin"
+#define OUT_PATH "bench-extsort-out.bin"
+#define NRECS    (8u << 20)
+
+typedef struct rec_s {
+    uint64_t key;
+    uint64_t payload;
+} rec_t;
+
+static int _cmp(const void* a, const void* b) {
+    uint64_t x = ((const rec_t*)a)->key;
+    uint64_t y = ((const rec_t*)b)->key;
+    return x < y ? -1 : x > y;
+}
+
+static int _write_input(void) {
+    FILE*    fp = fopen(IN_PATH, "wb");
+    rec_t    buf[4096];
+    uint64_t seed = 3;
+
+    if (!fp) {
+        return -1;
+    }
+    for (size_t i = 0; i < NRECS; i += 4096) {
+        for (size_t j = 0; j < 4096; j++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            buf[j].key = seed;
+            buf[j].payload = i + j;
+        }
+        fwrite(buf, sizeof(rec_t), 4096, fp);
+    }
+    return fclose(fp);
+}
+
+/* sort 128 MiB of 16-byte records under shrinking memory budgets, from
+ * fully in-memory to many spilled runs and a multi-pass merge.
+ */
+static void bench_extsort(size_t memory, size_t nthreads) {
+    xylem_extsort_opts_t opts = {
+        .memory = memory, .nthreads = nthreads, .iosize = 1 << 20};
+    char     name[64];
+    uint64_t start = bench_now_ns();
+
+    if (xylem_extsort_file(IN_PATH, OUT_PATH, sizeof(rec_t), _cmp, &opts)) {
+        printf("extsort failed\n");
+        return;
+    }
+    uint64_t ns = bench_now_ns() - start;
+    snprintf(
+        name,
+        sizeof(name),
+        "extsort 128M mem=%zuM threads=%zu",
+        memory >> 20,
+        nthreads);
+    BENCH_REPORT(name, NRECS, ns);
+}
+
+int main(void) {
+    if (_write_input() != 0) {
+        return 1;
+    }
+    bench_extsort((size_t)256 << 20, 4);
+    bench_extsort((size_t)32 << 20, 1);
+    bench_extsort((size_t)32 << 20, 4);
+    bench_extsort((size_t)8 << 20, 4);
+    remove(IN_PATH);
+    remove(OUT_PATH);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "bench.h"
+
+#define NELTS (1u << 20)
+#define HOLD_OPS 4000000
+
+typedef struct item_s {
+    uint64_t           key;
+    xylem_heap_node_t  hnode;
+    xylem_dheap_node_t dnode;
+    xylem_rheap_node_t rnode;
+    xylem_pheap_node_t pnode;
+} item_t;
+
+static item_t* items;
+
+static uint64_t _rand(uint64_t* seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 24;
+}
+
+static int
+_cmp(const xylem_heap_node_t* child, const xylem_heap_node_t* parent) {
+    uint64_t c = xylem_heap_entry(child, item_t, hnode)->key;
+    uint64_t p = xylem_heap_entry(parent, item_t, hnode)->key;
+    return c < p ? -1 : c > p;
+}
+
+XYLEM_HEAP_DEFINE(item_heap, item_t, hnode, key)
+
+static int
+_pcmp(const xylem_pheap_node_t* a, const xylem_pheap_node_t* b) {
+    uint64_t ka = xylem_heap_entry(a, item_t, pnode)->key;
+    uint64_t kb = xylem_heap_entry(b, item_t, pnode)->key;
+    return ka < kb ? -1 : ka > kb;
+}
+
+static void _fill(void) {
+    uint64_t seed = 42;
+    for (size_t i = 0; i < NELTS; i++) {
+        items[i].key = _rand(&seed);
+    }
+}
+
+/* fill the heap with NELTS random keys, then drain it. */
+static void bench_heap_fill_drain(void) {
+    xylem_heap_t heap;
+    uint64_t     start;
+
+    _fill();
+    xylem_heap_init(&heap, _cmp);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_heap_insert(&heap, &items[i].hnode);
+    }
+    BENCH_REPORT("heap insert (1M)", NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    while (!xylem_heap_empty(&heap)) {
+        bench_sink += xylem_heap_entry(
+            xylem_heap_root(&heap), item_t, hnode)->key;
+        xylem_heap_dequeue(&heap);
+    }
+    BENCH_REPORT("heap dequeue (1M)", NELTS, bench_now_ns() - start);
+}
+
+static void bench_heap_define_fill_drain(void) {
+    xylem_heap_t heap;
+    uint64_t     start;
+
+    _fill();
+    item_heap_init(&heap);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        item_heap_insert(&heap, &items[i]);
+    }
+    BENCH_REPORT("heap DEFINE insert (1M)", NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (item_t* it; (it = item_heap_pop(&heap)) != NULL;) {
+        bench_sink += it->key;
+    }
+    BENCH_REPORT("heap DEFINE dequeue (1M)", NELTS, bench_now_ns() - start);
+}
+
+static void bench_dheap_fill_drain(size_t d) {
+    xylem_dheap_t heap;
+    uint64_t      start;
+    char          name[64];
+
+    _fill();
+    xylem_dheap_init(&heap, d);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_dheap_insert(&heap, &items[i].dnode, items[i].key);
+    }
+    snprintf(name, sizeof(name), "dheap d=%zu insert (1M)", d);
+    BENCH_REPORT(name, NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    while (!xylem_dheap_empty(&heap)) {
+        bench_sink += heap.slots[0].key;
+        xylem_dheap_dequeue(&heap);
+    }
+    snprintf(name, sizeof(name), "dheap d=%zu dequeue (1M)", d);
+    BENCH_REPORT(name, NELTS, bench_now_ns() - start);
+    xylem_dheap_deinit(&heap);
+}
+
+/* timer-queue hold model: pop the earliest entry and re-arm it later,
+ * through the generic cmp and through XYLEM_HEAP_DEFINE. on a
+ * cache-resident heap the comparator call matters more than memory latency.
+ */
+static void bench_heap_define_hold(size_t resident) {
+    xylem_heap_t heap;
+    uint64_t     seed = 7;
+    uint64_t     start;
+    char         name[64];
+
+    _fill();
+    xylem_heap_init(&heap, _cmp);
+    for (size_t i = 0; i < resident; i++) {
+        xylem_heap_insert(&heap, &items[i].hnode);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = xylem_heap_entry(xylem_heap_root(&heap), item_t, hnode);
+        xylem_heap_dequeue(&heap);
+        it->key += _rand(&seed) & 0xffffff;
+        xylem_heap_insert(&heap, &it->hnode);
+    }
+    snprintf(name, sizeof(name), "heap hold (%zu resident)", resident);
+    BENCH_REPORT(name, HOLD_OPS, bench_now_ns() - start);
+
+    _fill();
+    seed = 7;
+    item_heap_init(&heap);
+    for (size_t i = 0; i < resident; i++) {
+        item_heap_insert(&heap, &items[i]);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = item_heap_pop(&heap);
+        it->key += _rand(&seed) & 0xffffff;
+        item_heap_insert(&heap, it);
+    }
+    snprintf(name, sizeof(name), "heap DEFINE hold (%zu resident)", resident);
+    BENCH_REPORT(name, HOLD_OPS, bench_now_ns() - start);
+}
+
+static void bench_dheap_hold(size_t d) {
+    xylem_dheap_t heap;
+    uint64_t      seed = 7;
+    uint64_t      start;
+    char          name[64];
+
+    _fill();
+    xylem_dheap_init(&heap, d);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_dheap_insert(&heap, &items[i].dnode, items[i].key);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = xylem_heap_entry(xylem_dheap_root(&heap), item_t, dnode);
+        xylem_dheap_dequeue(&heap);
+        it->key += _rand(&seed) & 0xffffff;
+        xylem_dheap_insert(&heap, &it->dnode, it->key);
+    }
+    snprintf(name, sizeof(name), "dheap d=%zu hold (1M resident)", d);
+    BENCH_REPORT(name, HOLD_OPS, bench_now_ns() - start);
+    xylem_dheap_deinit(&heap);
+}
+
+static void bench_rheap_fill_drain(void) {
+    xylem_rheap_t heap;
+    uint64_t      start;
+
+    _fill();
+    xylem_rheap_init(&heap);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_rheap_insert(&heap, &items[i].rnode, items[i].key);
+    }
+    BENCH_REPORT("rheap insert (1M)", NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    while (!xylem_rheap_empty(&heap)) {
+        bench_sink += xylem_rheap_root(&heap)->key;
+        xylem_rheap_dequeue(&heap);
+    }
+    BENCH_REPORT("rheap dequeue (1M)", NELTS, bench_now_ns() - start);
+}
+
+static void bench_rheap_hold(void) {
+    xylem_rheap_t heap;
+    uint64_t      seed = 7;
+    uint64_t      start;
+
+    _fill();
+    xylem_rheap_init(&heap);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_rheap_insert(&heap, &items[i].rnode, items[i].key);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        xylem_rheap_node_t* min = xylem_rheap_root(&heap);
+        xylem_rheap_dequeue(&heap);
+        xylem_rheap_insert(&heap, min, min->key + (_rand(&seed) & 0xffffff));
+    }
+    BENCH_REPORT("rheap hold (1M resident)", HOLD_OPS, bench_now_ns() - start);
+}
+
+static void bench_pheap_fill_drain(void) {
+    xylem_pheap_t heap;
+    uint64_t      start;
+
+    _fill();
+    xylem_pheap_init(&heap, _pcmp);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_pheap_insert(&heap, &items[i].pnode);
+    }
+    BENCH_REPORT("pheap insert (1M)", NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    while (!xylem_pheap_empty(&heap)) {
+        bench_sink += xylem_heap_entry(
+            xylem_pheap_root(&heap), item_t, pnode)->key;
+        xylem_pheap_dequeue(&heap);
+    }
+    BENCH_REPORT("pheap dequeue (1M)", NELTS, bench_now_ns() - start);
+}
+
+static void bench_pheap_hold(void) {
+    xylem_pheap_t heap;
+    uint64_t      seed = 7;
+    uint64_t      start;
+
+    _fill();
+    xylem_pheap_init(&heap, _pcmp);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_pheap_insert(&heap, &items[i].pnode);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = xylem_heap_entry(xylem_pheap_root(&heap), item_t, pnode);
+        xylem_pheap_dequeue(&heap);
+        it->key += _rand(&seed) & 0xffffff;
+        xylem_pheap_insert(&heap, &it->pnode);
+    }
+    BENCH_REPORT("pheap hold (1M resident)", HOLD_OPS, bench_now_ns() - start);
+    while (!xylem_pheap_empty(&heap)) {
+        xylem_pheap_dequeue(&heap);
+    }
+}
+
+/* lower random keys in place: update() for the binary heap, decrease()
+ * for the pairing heap.
+ */
+static void bench_decrease_key(void) {
+    xylem_heap_t  heap;
+    xylem_pheap_t pheap;
+    uint64_t      seed = 11;
+    uint64_t      start;
+
+    _fill();
+    xylem_heap_init(&heap, _cmp);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_heap_insert(&heap, &items[i].hnode);
+    }
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = &items[_rand(&seed) % NELTS];
+        it->key -= it->key >> 4;
+        xylem_heap_update(&heap, &it->hnode);
+    }
+    BENCH_REPORT("heap decrease-key (1M)", HOLD_OPS, bench_now_ns() - start);
+
+    _fill();
+    xylem_pheap_init(&pheap, _pcmp);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_pheap_insert(&pheap, &items[i].pnode);
+    }
+    xylem_pheap_dequeue(&pheap);
+    seed = 11;
+    start = bench_now_ns();
+    for (size_t i = 0; i < HOLD_OPS; i++) {
+        item_t* it = &items[_rand(&seed) % NELTS];
+        if (it->pnode.prev || &it->pnode == xylem_pheap_root(&pheap)) {
+            it->key -= it->key >> 4;
+            xylem_pheap_decrease(&pheap, &it->pnode);
+        }
+    }
+    BENCH_REPORT("pheap decrease-key (1M)", HOLD_OPS, bench_now_ns() - start);
+    while (!xylem_pheap_empty(&pheap)) {
+        xylem_pheap_dequeue(&pheap);
+    }
+}
+
+/* merge two 512K queues: node-by-node re-insert vs meld. */
+static void bench_meld(void) {
+    xylem_heap_t  h1, h2;
+    xylem_pheap_t p1, p2;
+    uint64_t      start;
+    size_t        half = NELTS / 2;
+
+    _fill();
+    xylem_heap_init(&h1, _cmp);
+    xylem_heap_init(&h2, _cmp);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_heap_insert(i < half ? &h1 : &h2, &items[i].hnode);
+    }
+    start = bench_now_ns();
+    while (!xylem_heap_empty(&h2)) {
+        xylem_heap_node_t* n = xylem_heap_root(&h2);
+        xylem_heap_dequeue(&h2);
+        xylem_heap_insert(&h1, n);
+    }
+    BENCH_REPORT("heap merge by re-insert (512K)", 1, bench_now_ns() - start);
+
+    xylem_pheap_init(&p1, _pcmp);
+    xylem_pheap_init(&p2, _pcmp);
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_pheap_insert(i < half ? &p1 : &p2, &items[i].pnode);
+    }
+    start = bench_now_ns();
+    xylem_pheap_meld(&p1, &p2);
+    BENCH_REPORT("pheap meld (512K)", 1, bench_now_ns() - start);
+    bench_sink += p1.nelts;
+}
+
+int main(void) {
+    items = malloc(NELTS * sizeof(item_t));
+    if (!items) {
+        return 1;
+    }
+    bench_heap_fill_drain();
+    bench_heap_define_fill_drain();
+    bench_dheap_fill_drain(2);
+    bench_dheap_fill_drain(4);
+    bench_dheap_fill_drain(8);
+    bench_rheap_fill_drain();
+    bench_pheap_fill_drain();
+    bench_heap_define_hold(4096);
+    bench_heap_define_hold(NELTS);
+    bench_dheap_hold(2);
+    bench_dheap_hold(4);
+    bench_dheap_hold(8);
+    bench_rheap_hold();
+    bench_pheap_hold();
+    bench_decrease_key();
+    bench_meld();
+    free(items);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "bench.h"
+
+#define NQUERY 100000
+
+typedef struct item_s {
+    xylem_itree_node_t node;
+} item_t;
+
+static uint64_t _rand(uint64_t* seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 24;
+}
+
+/* n short intervals over a space 64x larger than n, like leases or
+ * allocated regions; queries are short windows.
+ */
+static void bench_itree_vs_scan(size_t n) {
+    xylem_itree_t      itree;
+    xylem_itree_iter_t iter;
+    item_t*            items = malloc(n * sizeof(item_t));
+    uint64_t           space = (uint64_t)n * 64;
+    uint64_t           seed = 42;
+    uint64_t           start;
+    uint64_t           hits = 0;
+    size_t             nq = n > 1000 ? NQUERY * 1000 / n : NQUERY;
+    char               name[64];
+
+    xylem_itree_init(&itree);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t lo = _rand(&seed) % space;
+        xylem_itree_insert(&itree, &items[i].node, lo, lo + 1 + _rand(&seed) % 128);
+    }
+
+    seed = 7;
+    start = bench_now_ns();
+    for (size_t q = 0; q < nq; q++) {
+        uint64_t lo = _rand(&seed) % space;
+        xylem_itree_overlap_init(&iter, &itree, lo, lo + 64);
+        while (xylem_itree_iter_next(&iter)) {
+            hits++;
+        }
+    }
+    snprintf(name, sizeof(name), "itree overlap query (%zu)", n);
+    BENCH_REPORT(name, nq, bench_now_ns() - start);
+
+    seed = 7;
+    start = bench_now_ns();
+    for (size_t q = 0; q < nq; q++) {
+        uint64_t lo = _rand(&seed) % space;
+        uint64_t hi = lo + 64;
+        for (size_t i = 0; i < n; i++) {
+            hits += items[i].node.lo < hi && items[i].node.hi > lo;
+        }
+    }
+    snprintf(name, sizeof(name), "linear scan overlap query (%zu)", n);
+    BENCH_REPORT(name, nq, bench_now_ns() - start);
+
+    bench_sink += hits;
+    free(items);
+}
+
+int main(void) {
+    bench_itree_vs_scan(1000);
+    bench_itree_vs_scan(100000);
+    bench_itree_vs_scan(1000000);
+    return 0;
+}
\ No newline at end of file
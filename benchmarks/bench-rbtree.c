@@ -0,0 +1,215 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "bench.h"
+
+#define NELTS (1u << 20)
+#define NLOOKUP (1u << 20)
+#define BATCH   64
+
+typedef struct item_s {
+    uint64_t            key;
+    xylem_rbtree_node_t node;
+} item_t;
+
+static item_t*               items;
+static xylem_rbtree_node_t** nodes;
+
+XYLEM_RBTREE_DEFINE(item_map, item_t, node, key, uint64_t, XYLEM_RBTREE_CMP)
+
+static int _cmp_nn(const xylem_rbtree_node_t* a, const xylem_rbtree_node_t* b) {
+    uint64_t x = xylem_rbtree_entry(a, item_t, node)->key;
+    uint64_t y = xylem_rbtree_entry(b, item_t, node)->key;
+    return x < y ? -1 : x > y;
+}
+
+static int _cmp_kn(const void* key, const xylem_rbtree_node_t* n) {
+    uint64_t x = *(const uint64_t*)key;
+    uint64_t y = xylem_rbtree_entry(n, item_t, node)->key;
+    return x < y ? -1 : x > y;
+}
+
+/* load NELTS sorted keys one insert at a time, with the last node as
+ * hint, and with build_sorted.
+ */
+static void bench_rbtree_load_sorted(void) {
+    xylem_rbtree_t       tree;
+    xylem_rbtree_node_t* hint = NULL;
+    uint64_t             start;
+
+    for (size_t i = 0; i < NELTS; i++) {
+        items[i].key = i * 2;
+        nodes[i] = &items[i].node;
+    }
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_rbtree_insert(&tree, &items[i].node);
+    }
+    BENCH_REPORT("rbtree sorted insert (1M)", NELTS, bench_now_ns() - start);
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        xylem_rbtree_insert_hint(&tree, &items[i].node, hint);
+        hint = &items[i].node;
+    }
+    BENCH_REPORT("rbtree sorted insert_hint (1M)", NELTS, bench_now_ns() - start);
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    start = bench_now_ns();
+    xylem_rbtree_build_sorted(&tree, nodes, NELTS);
+    BENCH_REPORT("rbtree build_sorted (1M)", NELTS, bench_now_ns() - start);
+    bench_sink += (uintptr_t)tree.root;
+}
+
+/* expire the oldest quarter of a 1M tree: erase node by node versus one
+ * extract.
+ */
+static void bench_rbtree_expire(void) {
+    xylem_rbtree_t tree, out;
+    uint64_t       cut = NELTS / 2;
+    uint64_t       start;
+
+    for (size_t i = 0; i < NELTS; i++) {
+        items[i].key = i * 2;
+        nodes[i] = &items[i].node;
+    }
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    xylem_rbtree_build_sorted(&tree, nodes, NELTS);
+    start = bench_now_ns();
+    while (xylem_rbtree_first(&tree) &&
+           xylem_rbtree_entry(xylem_rbtree_first(&tree), item_t, node)->key < cut) {
+        xylem_rbtree_erase(&tree, xylem_rbtree_first(&tree));
+    }
+    BENCH_REPORT("rbtree expire 256K by erase", 1, bench_now_ns() - start);
+
+    xylem_rbtree_build_sorted(&tree, nodes, NELTS);
+    start = bench_now_ns();
+    xylem_rbtree_extract(&tree, NULL, &cut, &out);
+    BENCH_REPORT("rbtree expire 256K by extract", 1, bench_now_ns() - start);
+    bench_sink += (uintptr_t)out.root;
+}
+
+/* random lookups (half of them misses) into a tree of `n` nodes inserted
+ * in random order, one at a time versus in batches of BATCH.
+ */
+static void bench_rbtree_find(size_t n, const char* label) {
+    xylem_rbtree_t              tree;
+    static uint64_t             keys[NLOOKUP];
+    static const void*          kp[NLOOKUP];
+    static xylem_rbtree_node_t* out[BATCH];
+    uint64_t                    seed = 42;
+    uint64_t                    start;
+    size_t                      hits = 0;
+    char                        name[64];
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        items[i].key = (seed >> 20) << 1;
+        xylem_rbtree_insert(&tree, &items[i].node);
+    }
+    for (size_t i = 0; i < NLOOKUP; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        keys[i] = items[(seed >> 33) % n].key | ((seed >> 7) & 1);
+        kp[i] = &keys[i];
+    }
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < NLOOKUP; i++) {
+        hits += xylem_rbtree_find(&tree, kp[i]) != NULL;
+    }
+    snprintf(name, sizeof(name), "rbtree find (%s)", label);
+    BENCH_REPORT(name, NLOOKUP, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < NLOOKUP; i += BATCH) {
+        hits += xylem_rbtree_find_batch(&tree, kp + i, BATCH, out);
+    }
+    snprintf(name, sizeof(name), "rbtree find_batch x%d (%s)", BATCH, label);
+    BENCH_REPORT(name, NLOOKUP, bench_now_ns() - start);
+    bench_sink += hits;
+}
+
+/* random inserts and lookups on a cache-resident 16K-key map, where the
+ * comparator calls rather than misses dominate: through the comparator
+ * pointers versus the XYLEM_RBTREE_DEFINE functions.
+ */
+#define MAP_KEYS (1u << 14)
+
+static void bench_rbtree_define(void) {
+    xylem_rbtree_t tree;
+    uint64_t       seed = 42;
+    uint64_t       start;
+    size_t         hits = 0;
+
+    for (size_t i = 0; i < MAP_KEYS; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        items[i].key = seed >> 20;
+    }
+
+    start = bench_now_ns();
+    for (size_t round = 0; round < NELTS / MAP_KEYS; round++) {
+        xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+        for (size_t i = 0; i < MAP_KEYS; i++) {
+            xylem_rbtree_insert(&tree, &items[i].node);
+        }
+    }
+    BENCH_REPORT("rbtree insert (16K map)", NELTS, bench_now_ns() - start);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        uint64_t* key = &items[(i * 7919) % MAP_KEYS].key;
+        hits += xylem_rbtree_find(&tree, key) != NULL;
+    }
+    BENCH_REPORT("rbtree find (16K map)", NELTS, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t round = 0; round < NELTS / MAP_KEYS; round++) {
+        item_map_init(&tree);
+        for (size_t i = 0; i < MAP_KEYS; i++) {
+            item_map_insert(&tree, &items[i]);
+        }
+    }
+    BENCH_REPORT("rbtree DEFINE insert (16K map)", NELTS, bench_now_ns() - start);
+    start = bench_now_ns();
+    for (size_t i = 0; i < NELTS; i++) {
+        uint64_t key = items[(i * 7919) % MAP_KEYS].key;
+        hits += item_map_find(&tree, key) != NULL;
+    }
+    BENCH_REPORT("rbtree DEFINE find (16K map)", NELTS, bench_now_ns() - start);
+    bench_sink += hits;
+}
+
+int main(void) {
+    items = malloc(NELTS * sizeof(item_t));
+    nodes = malloc(NELTS * sizeof(xylem_rbtree_node_t*));
+    bench_rbtree_load_sorted();
+    bench_rbtree_expire();
+    bench_rbtree_find(1u << 14, "16K, cache resident");
+    bench_rbtree_find(NELTS, "1M, DRAM resident");
+    bench_rbtree_define();
+    free(nodes);
+    free(items);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "bench.h"
+
+#define RING_CAP 1024
+#define BATCH 32
+#define ITERATIONS 10000000
+
+typedef struct entry8_s {
+    uint64_t v[1];
+} entry8_t;
+
+typedef struct entry16_s {
+    uint64_t v[2];
+} entry16_t;
+
+typedef struct entry64_s {
+    uint64_t v[8];
+} entry64_t;
+
+XYLEM_RINGBUF_DEFINE(ring8, entry8_t, RING_CAP)
+XYLEM_RINGBUF_DEFINE(ring16, entry16_t, RING_CAP)
+XYLEM_RINGBUF_DEFINE(ring64, entry64_t, RING_CAP)
+
+static ring8_t  ring8;
+static ring16_t ring16;
+static ring64_t ring64;
+
+/* push/pop one entry at a time, then in batches, through both the generic
+ * ring and the specialized one.
+ */
+#define BENCH_RINGBUF(prefix, type)                                            \
+    static void bench_##prefix(void) {                                         \
+        type     in[BATCH] = {0};                                              \
+        type     out[BATCH];                                                   \
+        uint64_t start;                                                        \
+        uint64_t sum = 0;                                                      \
+                                                                               \
+        xylem_ringbuf_t* ring =                                                \
+            xylem_ringbuf_create(sizeof(type), RING_CAP * sizeof(type));       \
+        start = bench_now_ns();                                                \
+        for (uint64_t i = 0; i < ITERATIONS; i++) {                            \
+            in[0].v[0] = i;                                                    \
+            xylem_ringbuf_write(ring, in, 1);                                  \
+            xylem_ringbuf_read(ring, out, 1);                                  \
+            sum += out[0].v[0];                                                \
+        }                                                                      \
+        BENCH_REPORT(                                                          \
+            "xylem_ringbuf " #type " write+read",                              \
+            ITERATIONS,                                                        \
+            bench_now_ns() - start);                                           \
+                                                                               \
+        start = bench_now_ns();                                                \
+        for (uint64_t i = 0; i < ITERATIONS / BATCH; i++) {                    \
+            in[0].v[0] = i;                                                    \
+            xylem_ringbuf_write(ring, in, BATCH);                              \
+            xylem_ringbuf_read(ring, out, BATCH);                              \
+            sum += out[0].v[0];                                                \
+        }                                                                      \
+        BENCH_REPORT(                                                          \
+            "xylem_ringbuf " #type " batch write+read (per entry)",            \
+            ITERATIONS,                                                        \
+            bench_now_ns() - start);                                           \
+        xylem_ringbuf_destroy(ring);                                           \
+                                                                               \
+        prefix##_init(&prefix);                                                \
+        start = bench_now_ns();                                                \
+        for (uint64_t i = 0; i < ITERATIONS; i++) {                            \
+            in[0].v[0] = i;                                                    \
+            prefix##_push(&prefix, &in[0]);                                    \
+            prefix##_pop(&prefix, &out[0]);                                    \
+            sum += out[0].v[0];                                                \
+        }                                                                      \
+        BENCH_REPORT(                                                          \
+            "XYLEM_RINGBUF_DEFINE " #type " push+pop",                         \
+            ITERATIONS,                                                        \
+            bench_now_ns() - start);                                           \
+                                                                               \
+        start = bench_now_ns();                                                \
+        for (uint64_t i = 0; i < ITERATIONS / BATCH; i++) {                    \
+            in[0].v[0] = i;                                                    \
+            prefix##_write(&prefix, in, BATCH);                                \
+            prefix##_read(&prefix, out, BATCH);                                \
+            sum += out[0].v[0];                                                \
+        }                                                                      \
+        BENCH_REPORT(                                                          \
+            "XYLEM_RINGBUF_DEFINE " #type " batch write+read (per entry)",     \
+            ITERATIONS,                                                        \
+            bench_now_ns() - start);                                           \
+        bench_sink = sum;                                                      \
+    }
+
+BENCH_RINGBUF(ring8, entry8_t)
+BENCH_RINGBUF(ring16, entry16_t)
+BENCH_RINGBUF(ring64, entry64_t)
+
+int main(void) {
+    bench_ring8();
+    bench_ring16();
+    bench_ring64();
+    return 0;
+}
\ No newline at end of file
@@ -22,4 +22,13 @@ function(xylem_add_test test_name)
     if(XYLEM_ENABLE_COVERAGE AND UNIX)
         target_link_options(test-${test_name} PRIVATE --coverage)
     endif()
+endfunction()
+
+function(xylem_add_bench bench_name)
+    add_executable(bench-${bench_name} "bench-${bench_name}.c")
+    target_link_libraries(bench-${bench_name} PRIVATE xylem)
+
+    xylem_apply_sanitizer(bench-${bench_name} XYLEM_ENABLE_ASAN address)
+    xylem_apply_sanitizer(bench-${bench_name} XYLEM_ENABLE_TSAN thread)
+    xylem_apply_sanitizer(bench-${bench_name} XYLEM_ENABLE_UBSAN undefined)
 endfunction()
\ No newline at end of file
@@ -48,11 +48,18 @@ _Pragma("once")
 
 #include "xylem/xylem-sha1.h"
 #include "xylem/xylem-heap.h"
+#include "xylem/xylem-topk.h"
+#include "xylem/xylem-kmerge.h"
 #include "xylem/xylem-bswap.h"
 #include "xylem/xylem-sha256.h"
 #include "xylem/xylem-base64.h"
 #include "xylem/xylem-rbtree.h"
+#include "xylem/xylem-itree.h"
 #include "xylem/xylem-varint.h"
 #include "xylem/xylem-ringbuf.h"
+#include "xylem/xylem-disruptor.h"
+#include "xylem/xylem-timewheel.h"
+#include "xylem/xylem-multiqueue.h"
 #include "xylem/xylem-thrdpool.h"
-#include "xylem/xylem-waitgroup.h"
\ No newline at end of file
+#include "xylem/xylem-waitgroup.h"
+#include "xylem/xylem-extsort.h"
\ No newline at end of file
@@ -0,0 +1,73 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+typedef struct xylem_disruptor_s          xylem_disruptor_t;
+typedef struct xylem_disruptor_consumer_s xylem_disruptor_consumer_t;
+
+extern xylem_disruptor_t* xylem_disruptor_create(size_t esize, size_t bufsize);
+extern void xylem_disruptor_destroy(xylem_disruptor_t* disruptor);
+
+/**
+ * @brief Register a consumer that sees every published entry.
+ *
+ * The consumer only reads entries that all of `deps` have already released,
+ * which lets consumers form pipelines (B after A) or diamonds. The producer
+ * never overwrites an entry that some consumer has not released yet.
+ *
+ * @note Consumers must not be registered while the producer or other
+ *       consumers are running. A consumer without dependencies begins at
+ *       the current producer position; one with dependencies begins at the
+ *       lowest position among them, so it sees everything they have yet
+ *       to release.
+ *
+ * @return The consumer handle, owned by the disruptor; NULL on failure.
+ */
+extern xylem_disruptor_consumer_t* xylem_disruptor_subscribe(xylem_disruptor_t* disruptor, xylem_disruptor_consumer_t* const* deps, size_t ndeps);
+
+/**
+ * @brief Publish up to `entry_count` entries from the single producer thread.
+ *
+ * @return Number of entries published; fewer than requested when the slowest
+ *         consumer is a full ring behind.
+ */
+extern size_t xylem_disruptor_publish(xylem_disruptor_t* disruptor, const void* buf, size_t entry_count);
+
+/**
+ * @brief Number of entries the consumer may process right now.
+ *
+ * The entries are accessed in place with xylem_disruptor_entry() and handed
+ * back in one step with xylem_disruptor_release(), so a whole batch costs a
+ * single cursor update.
+ */
+extern size_t xylem_disruptor_poll(xylem_disruptor_consumer_t* consumer);
+extern void* xylem_disruptor_entry(xylem_disruptor_consumer_t* consumer, size_t index);
+extern void xylem_disruptor_release(xylem_disruptor_consumer_t* consumer, size_t entry_count);
+
+/**
+ * @brief Copy out and release up to `entry_count` entries.
+ *
+ * @return Number of entries copied to `buf`.
+ */
+extern size_t xylem_disruptor_read(xylem_disruptor_consumer_t* consumer, void* buf, size_t entry_count);
\ No newline at end of file
@@ -0,0 +1,54 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+typedef struct xylem_extsort_opts_s xylem_extsort_opts_t;
+
+struct xylem_extsort_opts_s {
+    size_t      memory;   /* working memory budget in bytes, 0 = 256 MiB */
+    size_t      nthreads; /* run generation threads, 0 = 4 */
+    size_t      iosize;   /* bytes per sequential read/write, 0 = 4 MiB */
+    const char* tmpdir;   /* directory for spilled runs, NULL = tmpfile() */
+};
+
+/**
+ * @brief Sort a file of fixed-size records that may not fit in memory.
+ *
+ * Chunks of the input are sorted in parallel on a xylem_thrdpool and
+ * spilled as runs to temporary files. The runs are then merged with
+ * xylem_kmerge, in several passes if there are more runs than the memory
+ * budget allows buffers for. Each run is read in `iosize` blocks, with the
+ * next block prefetched on the pool while the current one is merged.
+ *
+ * @param in    Input path; its size must be a multiple of `rsize`.
+ * @param out   Output path; may be the same as `in`. The sort writes a
+ *              temporary file next to it and only replaces `out` once it
+ *              has succeeded.
+ * @param rsize Record size in bytes.
+ * @param cmp   Record comparison, qsort convention.
+ * @param opts  Tuning knobs, NULL for defaults.
+ *
+ * @return 0 on success, -1 on I/O error, allocation failure or bad input.
+ */
+extern int xylem_extsort_file(const char* in, const char* out, size_t rsize, int (*cmp)(const void* a, const void* b), const xylem_extsort_opts_t* opts);
\ No newline at end of file
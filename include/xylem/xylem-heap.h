@@ -25,8 +25,15 @@ _Pragma("once")
 
 #define xylem_heap_entry(x, t, m) ((t *)((char *)(x) - offsetof(t, m)))
 
-typedef struct xylem_heap_s      xylem_heap_t;
-typedef struct xylem_heap_node_s xylem_heap_node_t;
+typedef struct xylem_heap_s       xylem_heap_t;
+typedef struct xylem_heap_node_s  xylem_heap_node_t;
+typedef struct xylem_dheap_s      xylem_dheap_t;
+typedef struct xylem_dheap_node_s xylem_dheap_node_t;
+typedef struct xylem_dheap_slot_s xylem_dheap_slot_t;
+typedef struct xylem_rheap_s      xylem_rheap_t;
+typedef struct xylem_rheap_node_s xylem_rheap_node_t;
+typedef struct xylem_pheap_s      xylem_pheap_t;
+typedef struct xylem_pheap_node_s xylem_pheap_node_t;
 
 struct xylem_heap_node_s {
     struct xylem_heap_node_s* left;
@@ -40,9 +47,270 @@ struct xylem_heap_s {
     int (*cmp)(const xylem_heap_node_t* child, const xylem_heap_node_t* parent);
 };
 
+/* swap parent with child. child moves closer to the root, parent moves away. */
+static inline void xylem_heap_node_swap(
+    xylem_heap_t* heap, xylem_heap_node_t* parent, xylem_heap_node_t* child) {
+    xylem_heap_node_t* sibling;
+    xylem_heap_node_t  t;
+
+    t = *parent;
+    *parent = *child;
+    *child = t;
+
+    parent->parent = child;
+    if (child->left == child) {
+        child->left = parent;
+        sibling = child->right;
+    } else {
+        child->right = parent;
+        sibling = child->left;
+    }
+    if (sibling != NULL) {
+        sibling->parent = child;
+    }
+    if (parent->left != NULL) {
+        parent->left->parent = parent;
+    }
+    if (parent->right != NULL) {
+        parent->right->parent = parent;
+    }
+    if (child->parent == NULL) {
+        heap->root = child;
+    } else if (child->parent->left == parent) {
+        child->parent->left = child;
+    } else {
+        child->parent->right = child;
+    }
+}
+
 extern void xylem_heap_init(xylem_heap_t* heap, int (*cmp)(const xylem_heap_node_t* child, const xylem_heap_node_t* parent));
 extern void xylem_heap_insert(xylem_heap_t* heap, xylem_heap_node_t* node);
 extern void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node);
 extern void xylem_heap_dequeue(xylem_heap_t* heap);
+
+/**
+ * @brief Place `node` at the next free position of the bottom row without
+ *        restoring heap order. Building block for XYLEM_HEAP_DEFINE.
+ */
+extern void xylem_heap_link(xylem_heap_t* heap, xylem_heap_node_t* node);
+
+/**
+ * @brief Take `node` out, moving the last node of the bottom row into its
+ *        place without restoring heap order.
+ *
+ * @return The node that moved and must be sifted, or NULL if none did.
+ */
+extern xylem_heap_node_t* xylem_heap_unlink(xylem_heap_t* heap, xylem_heap_node_t* node);
+
+/**
+ * @brief Restore heap order after the key of `node` changed in place.
+ *
+ * The node is sifted up or down from its current position, which is
+ * cheaper than a remove followed by an insert.
+ */
+extern void xylem_heap_update(xylem_heap_t* heap, xylem_heap_node_t* node);
 extern bool xylem_heap_empty(xylem_heap_t* heap);
-extern xylem_heap_node_t* xylem_heap_root(xylem_heap_t* heap);
\ No newline at end of file
+extern xylem_heap_node_t* xylem_heap_root(xylem_heap_t* heap);
+
+/**
+ * @brief Replace the heap's contents with `n` nodes in O(n).
+ *
+ * Uses bottom-up (Floyd) heapify. The `nodes` array is reordered in place
+ * and may be discarded afterwards. Any nodes already in the heap are dropped.
+ */
+extern void xylem_heap_build(xylem_heap_t* heap, xylem_heap_node_t** nodes, size_t n);
+
+/**
+ * @brief Insert `n` nodes, repairing the heap once when that is cheaper.
+ *
+ * Large batches rebuild the whole heap in O(size + n). Small batches, or
+ * batches where the scratch array cannot be allocated, fall back to
+ * individual inserts.
+ */
+extern void xylem_heap_insert_batch(xylem_heap_t* heap, xylem_heap_node_t** nodes, size_t n);
+
+/**
+ * @brief Generate a heap of `type` ordered by `type.key`, with the key
+ *        comparison inlined into the sift loops.
+ *
+ * `member` is the embedded xylem_heap_node_t. The generated functions work
+ * on a plain xylem_heap_t, and name##_init() installs a matching cmp, so
+ * the generic xylem_heap_* calls remain usable on the same heap.
+ */
+#define XYLEM_HEAP_DEFINE(name, type, member, key)                             \
+    static inline bool name##_less(                                            \
+        const xylem_heap_node_t* a, const xylem_heap_node_t* b) {              \
+        return xylem_heap_entry(a, type, member)->key <                        \
+               xylem_heap_entry(b, type, member)->key;                         \
+    }                                                                          \
+                                                                               \
+    static inline int name##_cmp(                                              \
+        const xylem_heap_node_t* child, const xylem_heap_node_t* parent) {     \
+        return name##_less(child, parent) ? -1                                 \
+                                          : name##_less(parent, child);        \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sift_up(                                         \
+        xylem_heap_t* heap, xylem_heap_node_t* node) {                         \
+        while (node->parent && name##_less(node, node->parent)) {              \
+            xylem_heap_node_swap(heap, node->parent, node);                    \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sift_down(                                       \
+        xylem_heap_t* heap, xylem_heap_node_t* node) {                         \
+        for (;;) {                                                             \
+            xylem_heap_node_t* smallest = node;                                \
+            if (node->left && name##_less(node->left, smallest)) {             \
+                smallest = node->left;                                         \
+            }                                                                  \
+            if (node->right && name##_less(node->right, smallest)) {           \
+                smallest = node->right;                                        \
+            }                                                                  \
+            if (smallest == node) {                                            \
+                break;                                                         \
+            }                                                                  \
+            xylem_heap_node_swap(heap, node, smallest);                        \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_init(xylem_heap_t* heap) {                       \
+        xylem_heap_init(heap, name##_cmp);                                     \
+    }                                                                          \
+                                                                               \
+    static inline void name##_insert(xylem_heap_t* heap, type* elm) {          \
+        xylem_heap_link(heap, &elm->member);                                   \
+        name##_sift_up(heap, &elm->member);                                    \
+    }                                                                          \
+                                                                               \
+    static inline void name##_remove(xylem_heap_t* heap, type* elm) {          \
+        xylem_heap_node_t* moved = xylem_heap_unlink(heap, &elm->member);      \
+        if (moved) {                                                           \
+            name##_sift_down(heap, moved);                                     \
+            name##_sift_up(heap, moved);                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_update(xylem_heap_t* heap, type* elm) {          \
+        xylem_heap_node_t* node = &elm->member;                                \
+        if (node->parent && name##_less(node, node->parent)) {                 \
+            name##_sift_up(heap, node);                                        \
+        } else {                                                               \
+            name##_sift_down(heap, node);                                      \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline type* name##_root(xylem_heap_t* heap) {                      \
+        return heap->root ? xylem_heap_entry(heap->root, type, member) : NULL; \
+    }                                                                          \
+                                                                               \
+    static inline type* name##_pop(xylem_heap_t* heap) {                       \
+        type* elm = name##_root(heap);                                         \
+        if (elm) {                                                             \
+            name##_remove(heap, elm);                                          \
+        }                                                                      \
+        return elm;                                                            \
+    }
+
+
+/* array-backed d-ary min-heap keyed by uint64_t. keys live inline in the
+ * slot array next to the node pointers, and each node records its slot so
+ * removal stays O(log n).
+ */
+struct xylem_dheap_node_s {
+    size_t index;
+};
+
+struct xylem_dheap_slot_s {
+    uint64_t                   key;
+    struct xylem_dheap_node_s* node;
+};
+
+struct xylem_dheap_s {
+    struct xylem_dheap_slot_s* slots;
+    size_t                     nelts;
+    size_t                     cap;
+    size_t                     d;
+};
+
+extern void xylem_dheap_init(xylem_dheap_t* heap, size_t d);
+extern void xylem_dheap_deinit(xylem_dheap_t* heap);
+extern int xylem_dheap_insert(xylem_dheap_t* heap, xylem_dheap_node_t* node, uint64_t key);
+extern void xylem_dheap_remove(xylem_dheap_t* heap, xylem_dheap_node_t* node);
+extern void xylem_dheap_update(xylem_dheap_t* heap, xylem_dheap_node_t* node, uint64_t key);
+extern void xylem_dheap_dequeue(xylem_dheap_t* heap);
+extern bool xylem_dheap_empty(xylem_dheap_t* heap);
+extern xylem_dheap_node_t* xylem_dheap_root(xylem_dheap_t* heap);
+extern uint64_t xylem_dheap_key(xylem_dheap_t* heap, xylem_dheap_node_t* node);
+
+/* radix heap for monotone uint64_t keys: bucket i > 0 holds keys whose
+ * highest bit differing from the last extracted minimum is bit i - 1, and
+ * bucket 0 holds keys equal to it. each key is redistributed at most 64
+ * times, so insert and dequeue are amortized O(1) in the key count.
+ */
+struct xylem_rheap_node_s {
+    uint64_t                   key;
+    struct xylem_rheap_node_s* prev;
+    struct xylem_rheap_node_s* next;
+    size_t                     bucket;
+};
+
+struct xylem_rheap_s {
+    struct xylem_rheap_node_s* buckets[65];
+    uint64_t                   mins[65];
+    uint64_t                   mask;
+    uint64_t                   last;
+    size_t                     nelts;
+};
+
+extern void xylem_rheap_init(xylem_rheap_t* heap);
+
+/**
+ * @brief Insert `node` with `key`.
+ *
+ * Keys should not be lower than xylem_rheap_last(). A lower key is treated
+ * as due now: it is dequeued before every key above the last minimum, but
+ * in no particular order relative to other such keys.
+ */
+extern void xylem_rheap_insert(xylem_rheap_t* heap, xylem_rheap_node_t* node, uint64_t key);
+extern void xylem_rheap_remove(xylem_rheap_t* heap, xylem_rheap_node_t* node);
+extern void xylem_rheap_dequeue(xylem_rheap_t* heap);
+extern bool xylem_rheap_empty(xylem_rheap_t* heap);
+extern xylem_rheap_node_t* xylem_rheap_root(xylem_rheap_t* heap);
+extern uint64_t xylem_rheap_last(xylem_rheap_t* heap);
+
+/* pairing heap: O(1) insert, meld and decrease-key, amortized O(log n)
+ * dequeue. `prev` points at the left sibling, or at the parent for a
+ * first child.
+ */
+struct xylem_pheap_node_s {
+    struct xylem_pheap_node_s* child;
+    struct xylem_pheap_node_s* next;
+    struct xylem_pheap_node_s* prev;
+};
+
+struct xylem_pheap_s {
+    struct xylem_pheap_node_s* root;
+    size_t                     nelts;
+    int (*cmp)(const xylem_pheap_node_t* a, const xylem_pheap_node_t* b);
+};
+
+extern void xylem_pheap_init(xylem_pheap_t* heap, int (*cmp)(const xylem_pheap_node_t* a, const xylem_pheap_node_t* b));
+extern void xylem_pheap_insert(xylem_pheap_t* heap, xylem_pheap_node_t* node);
+extern void xylem_pheap_remove(xylem_pheap_t* heap, xylem_pheap_node_t* node);
+extern void xylem_pheap_dequeue(xylem_pheap_t* heap);
+extern bool xylem_pheap_empty(xylem_pheap_t* heap);
+extern xylem_pheap_node_t* xylem_pheap_root(xylem_pheap_t* heap);
+
+/**
+ * @brief Move every node of `other` into `heap` in O(1); `other` is left
+ *        empty. Both heaps must use the same comparison.
+ */
+extern void xylem_pheap_meld(xylem_pheap_t* heap, xylem_pheap_t* other);
+
+/**
+ * @brief Restore heap order after the key of `node` decreased in place.
+ *
+ * For a key that grew, remove and re-insert the node instead.
+ */
+extern void xylem_pheap_decrease(xylem_pheap_t* heap, xylem_pheap_node_t* node);
\ No newline at end of file
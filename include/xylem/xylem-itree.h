@@ -0,0 +1,78 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+#define xylem_itree_entry(x, t, m) ((t *)((char *)(x) - offsetof(t, m)))
+
+typedef struct xylem_itree_s      xylem_itree_t;
+typedef struct xylem_itree_node_s xylem_itree_node_t;
+typedef struct xylem_itree_iter_s xylem_itree_iter_t;
+
+/* intrusive interval tree over half-open intervals [lo, hi). nodes are
+ * ordered by lo in an augmented rbtree; each node also keeps the largest
+ * hi in its subtree so queries can skip subtrees that end too early.
+ */
+struct xylem_itree_node_s {
+    xylem_rbtree_node_t rb;
+    uint64_t            lo;
+    uint64_t            hi;
+    uint64_t            max;
+};
+
+struct xylem_itree_s {
+    xylem_rbtree_t tree;
+};
+
+/* iterator over the nodes overlapping the query [lo, last], in lo order.
+ * the successor is looked up before a node is handed out, so the caller
+ * may erase the node it just got.
+ */
+struct xylem_itree_iter_s {
+    xylem_itree_node_t* next;
+    uint64_t            lo;
+    uint64_t            last;
+};
+
+extern void xylem_itree_init(xylem_itree_t* itree);
+
+/**
+ * @brief Insert `node` covering [lo, hi). Equal intervals may coexist.
+ */
+extern void xylem_itree_insert(xylem_itree_t* itree, xylem_itree_node_t* node, uint64_t lo, uint64_t hi);
+extern void xylem_itree_erase(xylem_itree_t* itree, xylem_itree_node_t* node);
+extern bool xylem_itree_empty(xylem_itree_t* itree);
+
+/**
+ * @brief Start iterating the nodes that overlap [lo, hi).
+ *
+ * Only subtrees holding a match, plus one boundary path, are entered, so
+ * a full enumeration of k matches stays close to O(log n + k).
+ */
+extern void xylem_itree_overlap_init(xylem_itree_iter_t* iter, xylem_itree_t* itree, uint64_t lo, uint64_t hi);
+
+/**
+ * @brief Start iterating the nodes that contain `point` (stabbing query).
+ */
+extern void xylem_itree_stab_init(xylem_itree_iter_t* iter, xylem_itree_t* itree, uint64_t point);
+extern xylem_itree_node_t* xylem_itree_iter_next(xylem_itree_iter_t* iter);
\ No newline at end of file
@@ -0,0 +1,53 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+typedef struct xylem_kmerge_s xylem_kmerge_t;
+
+/**
+ * @brief Refill callback: copy up to `cap` next elements of run `run` into
+ *        `buf`.
+ *
+ * @return Number of elements copied; 0 once the run is exhausted.
+ */
+typedef size_t (*xylem_kmerge_refill_fn)(void* ctx, size_t run, void* buf, size_t cap);
+
+/**
+ * @brief Create a k-way merge of `k` runs, each sorted ascending by `cmp`.
+ *
+ * A loser tree picks the next element with about log2(k) comparisons.
+ * Each run is read through a private buffer of `batch` elements, refilled
+ * by `refill` only when it drains. Equal elements come out in run order.
+ *
+ * @return The merge handle; NULL on failure.
+ */
+extern xylem_kmerge_t* xylem_kmerge_create(size_t k, size_t esize, size_t batch, int (*cmp)(const void* a, const void* b), xylem_kmerge_refill_fn refill, void* ctx);
+extern void xylem_kmerge_destroy(xylem_kmerge_t* merge);
+
+/**
+ * @brief Copy up to `n` next elements of the merged sequence to `out`.
+ *
+ * @return Number of elements written; less than `n` only at the end.
+ */
+extern size_t xylem_kmerge_next(xylem_kmerge_t* merge, void* out, size_t n);
\ No newline at end of file
@@ -0,0 +1,62 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+#define xylem_multiqueue_entry(x, t, m) ((t *)((char *)(x) - offsetof(t, m)))
+
+typedef struct xylem_multiqueue_s      xylem_multiqueue_t;
+typedef struct xylem_multiqueue_node_s xylem_multiqueue_node_t;
+
+struct xylem_multiqueue_node_s {
+    xylem_dheap_node_t heap;
+};
+
+/**
+ * @brief Create a relaxed concurrent min-priority queue over `nheaps`
+ *        internal heaps, each behind its own try-lock.
+ *
+ * Pushes go to a random heap and pops take the smaller top of two random
+ * heaps, so a pop returns one of the smallest keys rather than the
+ * smallest. Around 2-4 heaps per thread works well.
+ *
+ * @return The queue handle; NULL on failure.
+ */
+extern xylem_multiqueue_t* xylem_multiqueue_create(size_t nheaps);
+extern void xylem_multiqueue_destroy(xylem_multiqueue_t* mq);
+
+/**
+ * @brief Push `node` with priority `key`. Safe from any thread.
+ *
+ * @return 0 on success, -1 if the chosen heap could not grow.
+ */
+extern int xylem_multiqueue_push(xylem_multiqueue_t* mq, xylem_multiqueue_node_t* node, uint64_t key);
+
+/**
+ * @brief Pop a node with a near-minimal key. Safe from any thread.
+ *
+ * @return The node, with its key stored in `key` if non-NULL; NULL when
+ *         the queue is empty.
+ */
+extern xylem_multiqueue_node_t* xylem_multiqueue_pop(xylem_multiqueue_t* mq, uint64_t* key);
+extern size_t xylem_multiqueue_len(xylem_multiqueue_t* mq);
\ No newline at end of file
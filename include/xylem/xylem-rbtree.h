@@ -27,29 +27,274 @@ _Pragma("once")
 
 typedef struct xylem_rbtree_node_s xylem_rbtree_node_t;
 typedef struct xylem_rbtree_s      xylem_rbtree_t;
+typedef struct xylem_rbtree_range_s xylem_rbtree_range_t;
+typedef struct xylem_rbtree_snode_s xylem_rbtree_snode_t;
 
 typedef int (*xylem_rbtree_cmp_nn_fn_t)(const xylem_rbtree_node_t* first, const xylem_rbtree_node_t* second);
 typedef int (*xylem_rbtree_cmp_kn_fn_t)(const void* key, const xylem_rbtree_node_t* node);
 
+/* recompute the aggregate stored alongside `node` from `node` and its
+ * (already up to date) children.
+ */
+typedef void (*xylem_rbtree_augment_fn_t)(xylem_rbtree_node_t* node);
+
+#if defined(XYLEM_RBTREE_COMPACT)
+/* the color lives in the low bit of the parent pointer, which node
+ * alignment leaves free: 24 bytes per node instead of 32 on 64-bit.
+ */
+struct xylem_rbtree_node_s {
+    uintptr_t                   parent_color;
+    struct xylem_rbtree_node_s* right;
+    struct xylem_rbtree_node_s* left;
+};
+#else
 struct xylem_rbtree_node_s {
     struct xylem_rbtree_node_s* parent;
     struct xylem_rbtree_node_s* right;
     struct xylem_rbtree_node_s* left;
     char                        color;
 };
+#endif
 
 struct xylem_rbtree_s {
     xylem_rbtree_node_t* root;
+    xylem_rbtree_node_t* leftmost;
+    xylem_rbtree_node_t* rightmost;
     xylem_rbtree_cmp_nn_fn_t cmp_nn;
     xylem_rbtree_cmp_kn_fn_t cmp_kn;
+    xylem_rbtree_augment_fn_t augment;
+};
+
+/* node carrying its subtree size, for trees initialized with
+ * xylem_rbtree_size_augment.
+ */
+struct xylem_rbtree_snode_s {
+    xylem_rbtree_node_t node;
+    size_t              size;
+};
+
+/* iterator over the nodes in [lo, hi). the successor is looked up before a
+ * node is handed out, so the caller may erase the node it just got.
+ */
+struct xylem_rbtree_range_s {
+    xylem_rbtree_t*      tree;
+    xylem_rbtree_node_t* next;
+    const void*          hi;
 };
 
+/* use these rather than the node fields, which depend on the layout. */
+static inline xylem_rbtree_node_t* xylem_rbtree_parent(const xylem_rbtree_node_t* node) {
+#if defined(XYLEM_RBTREE_COMPACT)
+    return (xylem_rbtree_node_t*)(node->parent_color & ~(uintptr_t)1);
+#else
+    return node->parent;
+#endif
+}
+
+/* 0 for red, 1 for black. */
+static inline int xylem_rbtree_color(const xylem_rbtree_node_t* node) {
+#if defined(XYLEM_RBTREE_COMPACT)
+    return (int)(node->parent_color & 1);
+#else
+    return node->color;
+#endif
+}
+
 extern void xylem_rbtree_init(xylem_rbtree_t* tree, xylem_rbtree_cmp_nn_fn_t cmp_nn, xylem_rbtree_cmp_kn_fn_t cmp_kn);
+
+/**
+ * @brief Initialize a tree whose nodes carry an aggregate of their subtree.
+ *
+ * `augment` is called bottom-up on every node whose subtree changes:
+ * along the path of an insert or erase and on both nodes of a rotation.
+ */
+extern void xylem_rbtree_init_augmented(xylem_rbtree_t* tree, xylem_rbtree_cmp_nn_fn_t cmp_nn, xylem_rbtree_cmp_kn_fn_t cmp_kn, xylem_rbtree_augment_fn_t augment);
 extern void xylem_rbtree_insert(xylem_rbtree_t* tree, xylem_rbtree_node_t* node);
+
+/**
+ * @brief Insert `node` unless an equal node exists, in a single descent.
+ *
+ * @return The existing equal node, or NULL if `node` was inserted.
+ */
+extern xylem_rbtree_node_t* xylem_rbtree_insert_unique(xylem_rbtree_t* tree, xylem_rbtree_node_t* node);
+
+/**
+ * @brief Like xylem_rbtree_insert_unique(), starting from `hint`, the node
+ *        expected to precede `node` (NULL: `node` is expected first).
+ *
+ * A correct hint costs at most two comparisons plus the rebalance, so
+ * feeding nearly sorted keys with the last inserted node as hint is
+ * amortized O(1). A wrong hint falls back to a full descent.
+ */
+extern xylem_rbtree_node_t* xylem_rbtree_insert_hint(xylem_rbtree_t* tree, xylem_rbtree_node_t* node, xylem_rbtree_node_t* hint);
+
+/**
+ * @brief Link `node` at the empty slot `*link` below `parent` and rebalance,
+ *        keeping the cached ends and aggregates. Building block for
+ *        XYLEM_RBTREE_DEFINE.
+ */
+extern void xylem_rbtree_link(xylem_rbtree_t* tree, xylem_rbtree_node_t* node, xylem_rbtree_node_t* parent, xylem_rbtree_node_t** link);
+
+/**
+ * @brief Replace the tree's contents with `n` nodes in O(n).
+ *
+ * `nodes` must be strictly ascending; no comparisons are made. The result
+ * is perfectly balanced. Any nodes already in the tree are dropped.
+ */
+extern void xylem_rbtree_build_sorted(xylem_rbtree_t* tree, xylem_rbtree_node_t** nodes, size_t n);
+
 extern void xylem_rbtree_erase(xylem_rbtree_t* tree, xylem_rbtree_node_t* node);
 extern bool xylem_rbtree_empty(xylem_rbtree_t* tree);
 extern xylem_rbtree_node_t* xylem_rbtree_find(xylem_rbtree_t* tree, const void* key);
+
+/**
+ * @brief Look up `n` keys, storing each match (or NULL) in `out`.
+ *
+ * Several searches advance in lockstep and prefetch their next node, so
+ * the cache misses of a large tree overlap instead of queueing.
+ *
+ * @return Number of keys found.
+ */
+extern size_t xylem_rbtree_find_batch(xylem_rbtree_t* tree, const void* const* keys, size_t n, xylem_rbtree_node_t** out);
+
 extern xylem_rbtree_node_t* xylem_rbtree_next(xylem_rbtree_node_t* node);
 extern xylem_rbtree_node_t* xylem_rbtree_prev(xylem_rbtree_node_t* node);
 extern xylem_rbtree_node_t* xylem_rbtree_first(xylem_rbtree_t* tree);
-extern xylem_rbtree_node_t* xylem_rbtree_last(xylem_rbtree_t* tree);
\ No newline at end of file
+extern xylem_rbtree_node_t* xylem_rbtree_last(xylem_rbtree_t* tree);
+
+/**
+ * @brief First node whose key is not less than `key` (cmp_kn(key, n) <= 0).
+ */
+extern xylem_rbtree_node_t* xylem_rbtree_lower_bound(xylem_rbtree_t* tree, const void* key);
+
+/**
+ * @brief First node whose key is greater than `key` (cmp_kn(key, n) < 0).
+ */
+extern xylem_rbtree_node_t* xylem_rbtree_upper_bound(xylem_rbtree_t* tree, const void* key);
+
+/**
+ * @brief Start iterating the nodes with lo <= key < hi in order.
+ *
+ * A NULL `lo` starts at the first node, a NULL `hi` runs to the last.
+ */
+extern void xylem_rbtree_range_init(xylem_rbtree_range_t* range, xylem_rbtree_t* tree, const void* lo, const void* hi);
+extern xylem_rbtree_node_t* xylem_rbtree_range_next(xylem_rbtree_range_t* range);
+
+/**
+ * @brief Move the nodes below `key` to `left` and the rest to `right`, in
+ *        O(log n).
+ *
+ * Both outputs take `tree`'s comparators; either may be `tree` itself.
+ * Otherwise `tree` is left empty.
+ */
+extern void xylem_rbtree_split(xylem_rbtree_t* tree, const void* key, xylem_rbtree_t* left, xylem_rbtree_t* right);
+
+/**
+ * @brief Append every node of `right` to `left`, in O(log n).
+ *
+ * Every node of `right` must sort after every node of `left`. `right` is
+ * left empty.
+ */
+extern void xylem_rbtree_join(xylem_rbtree_t* left, xylem_rbtree_t* right);
+
+/**
+ * @brief Move the nodes with lo <= key < hi from `tree` into `out`, in
+ *        O(log n).
+ *
+ * A NULL `lo` or `hi` leaves that end open, as in xylem_rbtree_range_init().
+ * `out` takes `tree`'s comparators; its previous contents are dropped.
+ */
+extern void xylem_rbtree_extract(xylem_rbtree_t* tree, const void* lo, const void* hi, xylem_rbtree_t* out);
+
+/**
+ * @brief Subtree-size augmentation; every node must be embedded in an
+ *        xylem_rbtree_snode_t.
+ */
+extern void xylem_rbtree_size_augment(xylem_rbtree_node_t* node);
+
+/**
+ * @brief The node of zero-based rank `k` in a size-augmented tree, O(log n).
+ *
+ * @return The node, or NULL if `k` is not less than the node count.
+ */
+extern xylem_rbtree_node_t* xylem_rbtree_select(xylem_rbtree_t* tree, size_t k);
+
+/**
+ * @brief Zero-based rank of `node` in a size-augmented tree, O(log n).
+ */
+extern size_t xylem_rbtree_rank(xylem_rbtree_node_t* node);
+
+/* three-way comparison for arithmetic keys, for XYLEM_RBTREE_DEFINE. */
+#define XYLEM_RBTREE_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+/**
+ * @brief Generate an ordered map of `type` keyed by `type.key_member`, with
+ *        the key comparison inlined into the descents.
+ *
+ * `keytype` is the type of `key_member`. `cmp_expr(a, b)` is a function or
+ * function-like macro applied to two key values, returning <0, 0 or >0;
+ * XYLEM_RBTREE_CMP suits arithmetic keys. prefix##_find() takes the key by
+ * value. The functions work on a plain xylem_rbtree_t, and prefix##_init()
+ * installs matching comparators (whose key argument points to a `keytype`),
+ * so the generic xylem_rbtree_* calls remain usable on the same tree.
+ */
+#define XYLEM_RBTREE_DEFINE(                                                   \
+    prefix, type, node_member, key_member, keytype, cmp_expr)                  \
+    static inline type* prefix##_entry(const xylem_rbtree_node_t* node) {      \
+        return xylem_rbtree_entry(node, type, node_member);                    \
+    }                                                                          \
+                                                                               \
+    static inline int prefix##_cmp_nn(                                         \
+        const xylem_rbtree_node_t* a, const xylem_rbtree_node_t* b) {          \
+        return cmp_expr(                                                       \
+            prefix##_entry(a)->key_member, prefix##_entry(b)->key_member);     \
+    }                                                                          \
+                                                                               \
+    static inline int prefix##_cmp_kn(                                         \
+        const void* key, const xylem_rbtree_node_t* node) {                    \
+        return cmp_expr(                                                       \
+            *(const keytype*)key, prefix##_entry(node)->key_member);           \
+    }                                                                          \
+                                                                               \
+    static inline void prefix##_init(xylem_rbtree_t* tree) {                   \
+        xylem_rbtree_init(tree, prefix##_cmp_nn, prefix##_cmp_kn);             \
+    }                                                                          \
+                                                                               \
+    static inline type* prefix##_find(xylem_rbtree_t* tree, keytype key) {     \
+        xylem_rbtree_node_t* n = tree->root;                                   \
+        while (n) {                                                            \
+            int r = cmp_expr(key, prefix##_entry(n)->key_member);              \
+            if (r < 0) {                                                       \
+                n = n->left;                                                   \
+            } else if (r > 0) {                                                \
+                n = n->right;                                                  \
+            } else {                                                           \
+                return prefix##_entry(n);                                      \
+            }                                                                  \
+        }                                                                      \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    /* returns the existing element on a collision, NULL once inserted. */     \
+    static inline type* prefix##_insert(xylem_rbtree_t* tree, type* elm) {     \
+        xylem_rbtree_node_t** p = &tree->root;                                 \
+        xylem_rbtree_node_t*  parent = NULL;                                   \
+        while (*p) {                                                           \
+            parent = *p;                                                       \
+            int r = cmp_expr(                                                  \
+                elm->key_member, prefix##_entry(parent)->key_member);          \
+            if (r < 0) {                                                       \
+                p = &parent->left;                                             \
+            } else if (r > 0) {                                                \
+                p = &parent->right;                                            \
+            } else {                                                           \
+                return prefix##_entry(parent);                                 \
+            }                                                                  \
+        }                                                                      \
+        xylem_rbtree_link(tree, &elm->node_member, parent, p);                 \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline void prefix##_erase(xylem_rbtree_t* tree, type* elm) {       \
+        xylem_rbtree_erase(tree, &elm->node_member);                           \
+    }
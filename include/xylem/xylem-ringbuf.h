@@ -21,4 +21,215 @@
 
 _Pragma("once")
 
-#include "xylem.h"
\ No newline at end of file
+#include "xylem.h"
+
+typedef struct xylem_ringbuf_s xylem_ringbuf_t;
+
+enum {
+    /* keep the newest entries: a write to a full ring drops the oldest ones.
+     * one thread may write while any number of threads read or snapshot. */
+    XYLEM_RINGBUF_OVERWRITE = 1 << 0,
+    /* any number of threads or processes may write concurrently with a
+     * single reader. cannot be combined with XYLEM_RINGBUF_OVERWRITE. */
+    XYLEM_RINGBUF_MPSC = 1 << 1,
+    /* writers and readers wake threads sleeping in the *_wait calls. costs
+     * a full fence per write and read, so rings that never block leave it
+     * off; their *_wait calls still work but poll once a millisecond. */
+    XYLEM_RINGBUF_BLOCKING = 1 << 2,
+};
+
+extern xylem_ringbuf_t* xylem_ringbuf_create(size_t esize, size_t bufsize);
+extern xylem_ringbuf_t* xylem_ringbuf_create_ex(size_t esize, size_t bufsize, int flags);
+
+/**
+ * @brief Create a ring inside a named shared memory region.
+ *
+ * The positions, capacity and entry size live in the region next to the
+ * entries, so other processes can attach with xylem_ringbuf_open_shared()
+ * and use every ring function on it. Blocking waits use process-shared
+ * futexes. Destroying the creating handle also removes the name.
+ *
+ * @param name  Region name, e.g. "/my-ring" (POSIX) or "Local\my-ring" (Windows).
+ *
+ * @return The ring, or NULL if the name already exists or on failure.
+ */
+extern xylem_ringbuf_t* xylem_ringbuf_create_shared(const char* name, size_t esize, size_t bufsize, int flags);
+extern xylem_ringbuf_t* xylem_ringbuf_open_shared(const char* name);
+extern void xylem_ringbuf_destroy(xylem_ringbuf_t* ring);
+extern bool xylem_ringbuf_full(xylem_ringbuf_t* ring);
+extern bool xylem_ringbuf_empty(xylem_ringbuf_t* ring);
+extern size_t xylem_ringbuf_len(xylem_ringbuf_t* ring);
+extern size_t xylem_ringbuf_cap(xylem_ringbuf_t* ring);
+extern size_t xylem_ringbuf_avail(xylem_ringbuf_t* ring);
+extern size_t xylem_ringbuf_write(xylem_ringbuf_t* ring, const void* buf, size_t entry_count);
+extern size_t xylem_ringbuf_read(xylem_ringbuf_t* ring, void* buf, size_t entry_count);
+
+/**
+ * @brief Write all `entry_count` entries, waiting for space as needed.
+ *
+ * Spins briefly before sleeping on a futex. On a ring created with
+ * XYLEM_RINGBUF_BLOCKING the other side only issues a wake-up syscall while
+ * somebody is actually asleep; without it the wait polls every millisecond.
+ *
+ * @note Only Linux, and Windows for rings that are not shared, have a real
+ *       wake-up. Elsewhere sleepers poll the ring, every 100 us on other
+ *       Unix systems and every millisecond on Windows shared rings.
+ *
+ * @param timeout_ms  Maximum time to wait in milliseconds; -1 waits forever.
+ *
+ * @return Number of entries written; less than `entry_count` on timeout.
+ */
+extern size_t xylem_ringbuf_write_wait(xylem_ringbuf_t* ring, const void* buf, size_t entry_count, int timeout_ms);
+
+/**
+ * @brief Read up to `entry_count` entries, waiting until at least one exists.
+ *
+ * @param timeout_ms  Maximum time to wait in milliseconds; -1 waits forever.
+ *
+ * @return Number of entries read; 0 on timeout.
+ */
+extern size_t xylem_ringbuf_read_wait(xylem_ringbuf_t* ring, void* buf, size_t entry_count, int timeout_ms);
+
+/**
+ * @brief Copy the newest entries without consuming them.
+ *
+ * Safe to call while another thread writes, which makes it suitable for
+ * dumping an XYLEM_RINGBUF_OVERWRITE ring from a crash or signal path.
+ *
+ * @return Number of entries copied to `buf`, at most `entry_count`.
+ */
+extern size_t xylem_ringbuf_snapshot(xylem_ringbuf_t* ring, void* buf, size_t entry_count);
+
+/**
+ * @brief Number of entries an XYLEM_RINGBUF_OVERWRITE ring discarded before
+ *        they were read.
+ */
+extern uint64_t xylem_ringbuf_dropped(xylem_ringbuf_t* ring);
+
+/**
+ * @brief Fill the ring with bytes read from `fd`.
+ *
+ * Reads straight into the free space of the ring with a single readv(),
+ * using at most two segments (before and after the wrap point).
+ * Only rings with an entry size of 1 byte are supported.
+ *
+ * @return Number of bytes read; 0 on EOF or when the ring is full;
+ *         -1 on error with errno set (EINVAL if the entry size is not 1
+ *         or the ring was created with XYLEM_RINGBUF_OVERWRITE or
+ *         XYLEM_RINGBUF_MPSC).
+ */
+extern int64_t xylem_ringbuf_read_fd(xylem_ringbuf_t* ring, int fd);
+
+/**
+ * @brief Drain buffered bytes from the ring into `fd`.
+ *
+ * Writes straight from the ring with a single writev(), using at most two
+ * segments. Only rings with an entry size of 1 byte are supported.
+ *
+ * @return Number of bytes written; 0 when the ring is empty;
+ *         -1 on error with errno set (EINVAL if the entry size is not 1
+ *         or the ring was created with XYLEM_RINGBUF_OVERWRITE).
+ */
+extern int64_t xylem_ringbuf_write_fd(xylem_ringbuf_t* ring, int fd);
+
+#define XYLEM_RINGBUF_CACHELINE 64
+
+/**
+ * @brief Generate a statically sized ring specialized for one entry type.
+ *
+ * Emits `name_t` together with inline `name_init`, `name_push`, `name_pop`,
+ * `name_write`, `name_read`, `name_len`, `name_cap`, `name_empty` and
+ * `name_full`. With `type` and the power-of-two `cap` known at compile time,
+ * pushes and pops become plain loads and stores. Like xylem_ringbuf_t, the
+ * generated ring is safe for one producer and one consumer thread. The
+ * indices are padded a cache line apart, so producer and consumer do not
+ * contend on the same line.
+ */
+#define XYLEM_RINGBUF_DEFINE(name, type, cap)                                  \
+    _Static_assert(                                                            \
+        (cap) > 0 && ((cap) & ((cap) - 1)) == 0,                               \
+        #name ": capacity must be a power of two");                            \
+                                                                               \
+    typedef struct name##_s {                                                  \
+        _Atomic uint64_t wpos;                                                 \
+        char             wpad[XYLEM_RINGBUF_CACHELINE - sizeof(uint64_t)];     \
+        _Atomic uint64_t rpos;                                                 \
+        char             rpad[XYLEM_RINGBUF_CACHELINE - sizeof(uint64_t)];     \
+        type             buf[(cap)];                                           \
+    } name##_t;                                                                \
+                                                                               \
+    static inline void name##_init(name##_t* ring) {                           \
+        atomic_init(&ring->wpos, 0);                                           \
+        atomic_init(&ring->rpos, 0);                                           \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_cap(const name##_t* ring) {                    \
+        (void)ring;                                                            \
+        return (cap);                                                          \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_len(name##_t* ring) {                          \
+        uint64_t r = atomic_load_explicit(&ring->rpos, memory_order_acquire);  \
+        uint64_t w = atomic_load_explicit(&ring->wpos, memory_order_acquire);  \
+        return (size_t)(w - r);                                                \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_empty(name##_t* ring) {                          \
+        return name##_len(ring) == 0;                                          \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_full(name##_t* ring) {                           \
+        return name##_len(ring) == (cap);                                      \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_push(name##_t* ring, const type* entry) {        \
+        uint64_t w = atomic_load_explicit(&ring->wpos, memory_order_relaxed);  \
+        uint64_t r = atomic_load_explicit(&ring->rpos, memory_order_acquire);  \
+        if (w - r == (cap)) {                                                  \
+            return false;                                                      \
+        }                                                                      \
+        ring->buf[w & ((cap) - 1)] = *entry;                                   \
+        atomic_store_explicit(&ring->wpos, w + 1, memory_order_release);       \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_pop(name##_t* ring, type* entry) {               \
+        uint64_t r = atomic_load_explicit(&ring->rpos, memory_order_relaxed);  \
+        uint64_t w = atomic_load_explicit(&ring->wpos, memory_order_acquire);  \
+        if (w == r) {                                                          \
+            return false;                                                      \
+        }                                                                      \
+        *entry = ring->buf[r & ((cap) - 1)];                                   \
+        atomic_store_explicit(&ring->rpos, r + 1, memory_order_release);       \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_write(                                         \
+        name##_t* ring, const type* entries, size_t count) {                   \
+        uint64_t w = atomic_load_explicit(&ring->wpos, memory_order_relaxed);  \
+        uint64_t r = atomic_load_explicit(&ring->rpos, memory_order_acquire);  \
+        size_t   avail = (size_t)((cap) - (w - r));                            \
+        if (count > avail) {                                                   \
+            count = avail;                                                     \
+        }                                                                      \
+        for (size_t i = 0; i < count; i++) {                                   \
+            ring->buf[(w + i) & ((cap) - 1)] = entries[i];                     \
+        }                                                                      \
+        atomic_store_explicit(&ring->wpos, w + count, memory_order_release);   \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_read(                                          \
+        name##_t* ring, type* entries, size_t count) {                         \
+        uint64_t r = atomic_load_explicit(&ring->rpos, memory_order_relaxed);  \
+        uint64_t w = atomic_load_explicit(&ring->wpos, memory_order_acquire);  \
+        size_t   len = (size_t)(w - r);                                        \
+        if (count > len) {                                                     \
+            count = len;                                                       \
+        }                                                                      \
+        for (size_t i = 0; i < count; i++) {                                   \
+            entries[i] = ring->buf[(r + i) & ((cap) - 1)];                     \
+        }                                                                      \
+        atomic_store_explicit(&ring->rpos, r + count, memory_order_release);   \
+        return count;                                                          \
+    }
@@ -21,4 +21,22 @@
 
 _Pragma("once")
 
-#include "xylem.h"
\ No newline at end of file
+#include "xylem.h"
+
+typedef struct xylem_thrdpool_s xylem_thrdpool_t;
+
+/**
+ * @brief Create a pool of `nthrds` threads.
+ *
+ * @return The pool, or NULL if memory ran out or no thread could be started.
+ */
+extern xylem_thrdpool_t* xylem_thrdpool_create(int nthrds);
+
+/**
+ * @brief Queue `routine(arg)` to run on a pool thread.
+ *
+ * @return 0 on success, -1 if the job could not be queued; `routine` is
+ *         then never called.
+ */
+extern int xylem_thrdpool_post(xylem_thrdpool_t* restrict pool, void (*routine)(void*), void* arg);
+extern void xylem_thrdpool_destroy(xylem_thrdpool_t* restrict pool);
\ No newline at end of file
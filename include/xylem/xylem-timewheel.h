@@ -0,0 +1,79 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+#define XYLEM_TIMEWHEEL_BITS   6
+#define XYLEM_TIMEWHEEL_SLOTS  (1 << XYLEM_TIMEWHEEL_BITS)
+#define XYLEM_TIMEWHEEL_LEVELS 4
+
+#define xylem_timewheel_entry(x, t, m) ((t *)((char *)(x) - offsetof(t, m)))
+
+typedef struct xylem_timewheel_s      xylem_timewheel_t;
+typedef struct xylem_timewheel_node_s xylem_timewheel_node_t;
+
+/* hierarchical timing wheel. ticks are whatever unit the caller feeds to
+ * xylem_timewheel_advance(), usually milliseconds. level l covers
+ * 64^(l+1) ticks; timers further out wait in an overflow heap.
+ */
+struct xylem_timewheel_node_s {
+    uint64_t                       expire;
+    struct xylem_timewheel_node_s* prev;
+    struct xylem_timewheel_node_s* next;
+    xylem_heap_node_t              heap;
+    int                            level;
+    unsigned                       slot;
+};
+
+struct xylem_timewheel_s {
+    struct xylem_timewheel_node_s* slots[XYLEM_TIMEWHEEL_LEVELS][XYLEM_TIMEWHEEL_SLOTS];
+    uint64_t                       masks[XYLEM_TIMEWHEEL_LEVELS];
+    xylem_heap_t                   overflow;
+    uint64_t                       now;
+    size_t                         nelts;
+};
+
+extern void xylem_timewheel_init(xylem_timewheel_t* wheel, uint64_t now);
+extern void xylem_timewheel_node_init(xylem_timewheel_node_t* node);
+
+/**
+ * @brief Arm `node` to expire at tick `expire`, in O(1).
+ *
+ * Expiry times at or before the current tick fire on the next advance.
+ * An already armed node is re-armed.
+ */
+extern void xylem_timewheel_add(xylem_timewheel_t* wheel, xylem_timewheel_node_t* node, uint64_t expire);
+extern void xylem_timewheel_cancel(xylem_timewheel_t* wheel, xylem_timewheel_node_t* node);
+extern void xylem_timewheel_reset(xylem_timewheel_t* wheel, xylem_timewheel_node_t* node, uint64_t expire);
+extern bool xylem_timewheel_pending(xylem_timewheel_node_t* node);
+extern bool xylem_timewheel_empty(xylem_timewheel_t* wheel);
+
+/**
+ * @brief Move the wheel forward to tick `now`, firing every timer due.
+ *
+ * Timers are disarmed before `cb` runs, so the callback may re-arm or
+ * cancel any timer, including the one it was called for.
+ *
+ * @return Number of timers fired.
+ */
+extern size_t xylem_timewheel_advance(xylem_timewheel_t* wheel, uint64_t now, void (*cb)(xylem_timewheel_node_t* node, void* arg), void* arg);
\ No newline at end of file
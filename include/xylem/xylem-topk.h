@@ -0,0 +1,63 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+_Pragma("once")
+
+#include "xylem.h"
+
+typedef struct xylem_topk_s xylem_topk_t;
+
+/**
+ * @brief Create a selector that keeps the `k` largest of the elements
+ *        pushed so far, ordered by `cmp` (qsort convention).
+ *
+ * Elements are copied into storage allocated once here; pushing never
+ * allocates.
+ *
+ * @return The selector; NULL on failure.
+ */
+extern xylem_topk_t* xylem_topk_create(size_t k, size_t esize, int (*cmp)(const void* a, const void* b));
+extern void xylem_topk_destroy(xylem_topk_t* topk);
+extern void xylem_topk_reset(xylem_topk_t* topk);
+
+/**
+ * @brief Offer one element.
+ *
+ * Once k elements are held, anything not greater than the current
+ * threshold is rejected with a single comparison.
+ *
+ * @return true if the element was kept.
+ */
+extern bool xylem_topk_push(xylem_topk_t* topk, const void* elem);
+
+/**
+ * @brief The smallest element kept, i.e. the bar a new element has to
+ *        clear; NULL until k elements have been pushed.
+ */
+extern const void* xylem_topk_threshold(xylem_topk_t* topk);
+extern size_t xylem_topk_len(xylem_topk_t* topk);
+
+/**
+ * @brief Copy the kept elements to `out` in descending order.
+ *
+ * @return Number of elements written.
+ */
+extern size_t xylem_topk_sorted(xylem_topk_t* topk, void* out);
\ No newline at end of file
@@ -19,4 +19,97 @@
  *  IN THE SOFTWARE.
  */
 
-_Pragma("once")
\ No newline at end of file
+_Pragma("once")
+
+#include "xylem.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+typedef struct platform_iovec_s platform_iovec_t;
+typedef struct platform_shm_s   platform_shm_t;
+
+struct platform_iovec_s {
+    void*  base;
+    size_t len;
+};
+
+struct platform_shm_s {
+    void*  addr;
+    size_t size;
+    void*  handle;
+};
+
+extern int64_t platform_io_readv(int fd, const platform_iovec_t* iov, int iovcnt);
+extern int64_t platform_io_writev(int fd, const platform_iovec_t* iov, int iovcnt);
+
+extern int  platform_futex_wait(_Atomic uint32_t* addr, uint32_t expected, int timeout_ms, bool shared);
+extern void platform_futex_wake(_Atomic uint32_t* addr, bool all, bool shared);
+
+extern int  platform_shm_create(platform_shm_t* shm, const char* name, size_t size);
+extern int  platform_shm_open(platform_shm_t* shm, const char* name);
+extern void platform_shm_close(platform_shm_t* shm);
+extern void platform_shm_unlink(const char* name);
+
+extern uint64_t platform_clock_ms(void);
+extern uint64_t platform_clock_ns(void);
+
+static inline void platform_cpu_relax(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/* hint that `p` will be read soon; never faults. */
+static inline void platform_prefetch(const void* p) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __prefetch(p);
+#else
+    __builtin_prefetch(p);
+#endif
+}
+
+/* x must be non-zero. */
+static inline int platform_clz64(uint64_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long i;
+    _BitScanReverse64(&i, x);
+    return 63 - (int)i;
+#elif defined(_MSC_VER)
+    unsigned long i;
+    if (_BitScanReverse(&i, (unsigned long)(x >> 32))) {
+        return 31 - (int)i;
+    }
+    _BitScanReverse(&i, (unsigned long)x);
+    return 63 - (int)i;
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+/* x must be non-zero. */
+static inline int platform_ctz64(uint64_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#elif defined(_MSC_VER)
+    unsigned long i;
+    if (_BitScanForward(&i, (unsigned long)x)) {
+        return (int)i;
+    }
+    _BitScanForward(&i, (unsigned long)(x >> 32));
+    return 32 + (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "platform/platform.h"
+
+#include <errno.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+int platform_futex_wait(
+    _Atomic uint32_t* addr, uint32_t expected, int timeout_ms, bool shared) {
+    struct timespec  ts;
+    struct timespec* pts = NULL;
+
+    if (timeout_ms >= 0) {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+        pts = &ts;
+    }
+    int  op = shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE;
+    long ret = syscall(SYS_futex, (uint32_t*)addr, op, expected, pts, NULL, 0);
+    if (ret == -1 && errno == ETIMEDOUT) {
+        return -1;
+    }
+    return 0;
+}
+
+void platform_futex_wake(_Atomic uint32_t* addr, bool all, bool shared) {
+    syscall(
+        SYS_futex,
+        (uint32_t*)addr,
+        shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE,
+        all ? INT_MAX : 1,
+        NULL,
+        NULL,
+        0);
+}
+#else
+/* no portable futex outside linux: poll the word with short sleeps. */
+int platform_futex_wait(
+    _Atomic uint32_t* addr, uint32_t expected, int timeout_ms, bool shared) {
+    struct timespec ts = {.tv_sec = 0, .tv_nsec = 100000};
+    uint64_t        deadline = platform_clock_ms() + (uint64_t)timeout_ms;
+
+    (void)shared;
+    while (atomic_load_explicit(addr, memory_order_acquire) == expected) {
+        if (timeout_ms >= 0 && platform_clock_ms() >= deadline) {
+            return -1;
+        }
+        nanosleep(&ts, NULL);
+    }
+    return 0;
+}
+
+void platform_futex_wake(_Atomic uint32_t* addr, bool all, bool shared) {
+    (void)addr;
+    (void)all;
+    (void)shared;
+}
+#endif
\ No newline at end of file
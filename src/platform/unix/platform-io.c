@@ -0,0 +1,64 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "platform/platform.h"
+
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+int64_t platform_io_readv(int fd, const platform_iovec_t* iov, int iovcnt) {
+    struct iovec vec[2];
+    ssize_t      n;
+
+    if (iovcnt <= 0 || iovcnt > 2) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        vec[i].iov_base = iov[i].base;
+        vec[i].iov_len = iov[i].len;
+    }
+    do {
+        n = readv(fd, vec, iovcnt);
+    } while (n < 0 && errno == EINTR);
+
+    return (int64_t)n;
+}
+
+int64_t platform_io_writev(int fd, const platform_iovec_t* iov, int iovcnt) {
+    struct iovec vec[2];
+    ssize_t      n;
+
+    if (iovcnt <= 0 || iovcnt > 2) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        vec[i].iov_base = iov[i].base;
+        vec[i].iov_len = iov[i].len;
+    }
+    do {
+        n = writev(fd, vec, iovcnt);
+    } while (n < 0 && errno == EINTR);
+
+    return (int64_t)n;
+}
\ No newline at end of file
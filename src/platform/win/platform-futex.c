@@ -0,0 +1,67 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "platform/platform.h"
+
+#include <windows.h>
+
+/* WaitOnAddress only works within one process, so waits on shared memory
+ * poll the word instead.
+ */
+static int _futex_poll(
+    _Atomic uint32_t* addr, uint32_t expected, int timeout_ms) {
+    ULONGLONG deadline = GetTickCount64() + (ULONGLONG)timeout_ms;
+
+    while (atomic_load_explicit(addr, memory_order_acquire) == expected) {
+        if (timeout_ms >= 0 && GetTickCount64() >= deadline) {
+            return -1;
+        }
+        Sleep(1);
+    }
+    return 0;
+}
+
+int platform_futex_wait(
+    _Atomic uint32_t* addr, uint32_t expected, int timeout_ms, bool shared) {
+    DWORD timeout = (timeout_ms < 0) ? INFINITE : (DWORD)timeout_ms;
+
+    if (shared) {
+        return _futex_poll(addr, expected, timeout_ms);
+    }
+    if (!WaitOnAddress(
+            (volatile VOID*)addr, &expected, sizeof(expected), timeout)) {
+        if (GetLastError() == ERROR_TIMEOUT) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void platform_futex_wake(_Atomic uint32_t* addr, bool all, bool shared) {
+    if (shared) {
+        return;
+    }
+    if (all) {
+        WakeByAddressAll((PVOID)addr);
+    } else {
+        WakeByAddressSingle((PVOID)addr);
+    }
+}
\ No newline at end of file
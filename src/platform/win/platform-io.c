@@ -0,0 +1,99 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "platform/platform.h"
+
+#include <io.h>
+#include <windows.h>
+
+/* bytes that can be read from `fd` without blocking, capped at `len`.
+ * disk files never block; pipes report what is buffered; anything else
+ * (consoles, sockets) is assumed to block.
+ */
+static unsigned int _io_ready(int fd, unsigned int len) {
+    HANDLE h = (HANDLE)_get_osfhandle(fd);
+    DWORD  avail = 0;
+
+    if (h == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    switch (GetFileType(h)) {
+    case FILE_TYPE_DISK:
+        return len;
+    case FILE_TYPE_PIPE:
+        if (!PeekNamedPipe(h, NULL, 0, NULL, &avail, NULL)) {
+            return 0;
+        }
+        return avail < len ? (unsigned int)avail : len;
+    default:
+        return 0;
+    }
+}
+
+/* emulates readv(): once some bytes are in, later segments only take what
+ * is available right away, so a pipe never blocks with data in hand.
+ */
+int64_t platform_io_readv(int fd, const platform_iovec_t* iov, int iovcnt) {
+    int64_t total = 0;
+
+    if (iovcnt <= 0 || iovcnt > 2) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        unsigned int len =
+            iov[i].len > INT_MAX ? INT_MAX : (unsigned int)iov[i].len;
+        if (total > 0 && (len = _io_ready(fd, len)) == 0) {
+            break;
+        }
+        int n = _read(fd, iov[i].base, len);
+        if (n < 0) {
+            return total > 0 ? total : -1;
+        }
+        total += n;
+        if ((unsigned int)n < len) {
+            break;
+        }
+    }
+    return total;
+}
+
+int64_t platform_io_writev(int fd, const platform_iovec_t* iov, int iovcnt) {
+    int64_t total = 0;
+
+    if (iovcnt <= 0 || iovcnt > 2) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        unsigned int len =
+            iov[i].len > INT_MAX ? INT_MAX : (unsigned int)iov[i].len;
+        int n = _write(fd, iov[i].base, len);
+        if (n < 0) {
+            return total > 0 ? total : -1;
+        }
+        total += n;
+        if ((unsigned int)n < len) {
+            break;
+        }
+    }
+    return total;
+}
\ No newline at end of file
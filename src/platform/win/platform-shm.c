@@ -0,0 +1,86 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "platform/platform.h"
+
+#include <windows.h>
+
+int platform_shm_create(platform_shm_t* shm, const char* name, size_t size) {
+    HANDLE h = CreateFileMappingA(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_READWRITE,
+        (DWORD)((uint64_t)size >> 32),
+        (DWORD)(size & 0xffffffff),
+        name);
+    if (!h) {
+        return -1;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(h);
+        return -1;
+    }
+    void* addr = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!addr) {
+        CloseHandle(h);
+        return -1;
+    }
+    shm->addr = addr;
+    shm->size = size;
+    shm->handle = h;
+    return 0;
+}
+
+int platform_shm_open(platform_shm_t* shm, const char* name) {
+    MEMORY_BASIC_INFORMATION info;
+
+    HANDLE h = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    if (!h) {
+        return -1;
+    }
+    void* addr = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!addr) {
+        CloseHandle(h);
+        return -1;
+    }
+    if (VirtualQuery(addr, &info, sizeof(info)) == 0) {
+        UnmapViewOfFile(addr);
+        CloseHandle(h);
+        return -1;
+    }
+    shm->addr = addr;
+    shm->size = info.RegionSize;
+    shm->handle = h;
+    return 0;
+}
+
+void platform_shm_close(platform_shm_t* shm) {
+    UnmapViewOfFile(shm->addr);
+    CloseHandle((HANDLE)shm->handle);
+    shm->addr = NULL;
+    shm->size = 0;
+    shm->handle = NULL;
+}
+
+/* named mappings vanish with their last handle. */
+void platform_shm_unlink(const char* name) {
+    (void)name;
+}
\ No newline at end of file
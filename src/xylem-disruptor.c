@@ -0,0 +1,286 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+
+#define DISRUPTOR_CACHELINE 64
+
+/* malloc does not align to cache lines, so each hot field is padded by a
+ * full line on both sides to keep it alone on its line.
+ */
+struct xylem_disruptor_consumer_s {
+    char             lpad[DISRUPTOR_CACHELINE];
+    _Atomic uint64_t seq; /* next sequence to process */
+    char             pad[DISRUPTOR_CACHELINE - sizeof(uint64_t)];
+    uint64_t         limit; /* readable bound seen by the last poll */
+    bool             leaf;  /* no other consumer depends on this one */
+    size_t           ndeps;
+    xylem_disruptor_t*           disruptor;
+    xylem_disruptor_consumer_t** deps;
+};
+
+struct xylem_disruptor_s {
+    char             lpad[DISRUPTOR_CACHELINE];
+    _Atomic uint64_t cursor; /* next sequence to publish */
+    char             pad[DISRUPTOR_CACHELINE - sizeof(uint64_t)];
+    uint64_t         gate; /* cached sequence of the slowest consumer */
+    char             gpad[DISRUPTOR_CACHELINE - sizeof(uint64_t)];
+    char*            buf;
+    uint32_t         mask; /* mask = cap - 1 */
+    uint32_t         esz;  /* entry size (bytes) */
+    size_t           nconsumers;
+    xylem_disruptor_consumer_t** consumers;
+};
+
+static inline uint32_t _disruptor_rounddown_pow_of_two(uint32_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    return (n + 1) >> 1;
+}
+
+/* the producer only has to wait for consumers at the end of a dependency
+ * chain; everything upstream of them is at least as far ahead.
+ */
+static uint64_t _disruptor_min_gate(xylem_disruptor_t* disruptor, uint64_t w) {
+    uint64_t min = w;
+
+    for (size_t i = 0; i < disruptor->nconsumers; i++) {
+        xylem_disruptor_consumer_t* c = disruptor->consumers[i];
+        if (!c->leaf) {
+            continue;
+        }
+        uint64_t seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        if (seq < min) {
+            min = seq;
+        }
+    }
+    return min;
+}
+
+xylem_disruptor_t* xylem_disruptor_create(size_t esize, size_t bufsize) {
+    if (esize == 0 || bufsize < esize || esize > UINT32_MAX) {
+        return NULL;
+    }
+    size_t elem_count = bufsize / esize;
+    if (elem_count > UINT32_MAX) {
+        elem_count = UINT32_MAX;
+    }
+    uint32_t cap = _disruptor_rounddown_pow_of_two((uint32_t)elem_count);
+    if (cap == 0) {
+        return NULL;
+    }
+    xylem_disruptor_t* disruptor = malloc(sizeof(xylem_disruptor_t));
+    if (!disruptor) {
+        return NULL;
+    }
+    disruptor->buf = malloc((size_t)cap * esize);
+    if (!disruptor->buf) {
+        free(disruptor);
+        return NULL;
+    }
+    atomic_init(&disruptor->cursor, 0);
+    disruptor->gate = 0;
+    disruptor->mask = cap - 1;
+    disruptor->esz = (uint32_t)esize;
+    disruptor->nconsumers = 0;
+    disruptor->consumers = NULL;
+
+    return disruptor;
+}
+
+void xylem_disruptor_destroy(xylem_disruptor_t* disruptor) {
+    if (!disruptor) {
+        return;
+    }
+    for (size_t i = 0; i < disruptor->nconsumers; i++) {
+        free(disruptor->consumers[i]->deps);
+        free(disruptor->consumers[i]);
+    }
+    free(disruptor->consumers);
+    free(disruptor->buf);
+    free(disruptor);
+}
+
+xylem_disruptor_consumer_t* xylem_disruptor_subscribe(
+    xylem_disruptor_t*                 disruptor,
+    xylem_disruptor_consumer_t* const* deps,
+    size_t                             ndeps) {
+
+    for (size_t i = 0; i < ndeps; i++) {
+        if (!deps[i] || deps[i]->disruptor != disruptor) {
+            return NULL;
+        }
+    }
+    xylem_disruptor_consumer_t** consumers = realloc(
+        disruptor->consumers,
+        (disruptor->nconsumers + 1) * sizeof(xylem_disruptor_consumer_t*));
+    if (!consumers) {
+        return NULL;
+    }
+    disruptor->consumers = consumers;
+
+    xylem_disruptor_consumer_t* consumer =
+        malloc(sizeof(xylem_disruptor_consumer_t));
+    if (!consumer) {
+        return NULL;
+    }
+    consumer->deps = NULL;
+    if (ndeps) {
+        consumer->deps = malloc(ndeps * sizeof(xylem_disruptor_consumer_t*));
+        if (!consumer->deps) {
+            free(consumer);
+            return NULL;
+        }
+        memcpy(
+            consumer->deps, deps, ndeps * sizeof(xylem_disruptor_consumer_t*));
+    }
+    uint64_t w = atomic_load_explicit(&disruptor->cursor, memory_order_relaxed);
+
+    /* a late dependent starts where its slowest dependency is, so it
+     * never sits ahead of what it is allowed to read. */
+    for (size_t i = 0; i < ndeps; i++) {
+        uint64_t dep =
+            atomic_load_explicit(&deps[i]->seq, memory_order_acquire);
+        if (dep < w) {
+            w = dep;
+        }
+    }
+    atomic_init(&consumer->seq, w);
+    consumer->limit = w;
+    consumer->leaf = true;
+    consumer->ndeps = ndeps;
+    consumer->disruptor = disruptor;
+    for (size_t i = 0; i < ndeps; i++) {
+        deps[i]->leaf = false;
+    }
+    disruptor->consumers[disruptor->nconsumers++] = consumer;
+
+    return consumer;
+}
+
+size_t xylem_disruptor_publish(
+    xylem_disruptor_t* disruptor, const void* buf, size_t entry_count) {
+
+    uint64_t w = atomic_load_explicit(&disruptor->cursor, memory_order_relaxed);
+    uint32_t cap = disruptor->mask + 1;
+
+    /* only rescan the consumers once the cached gate runs out of room. */
+    if (w - disruptor->gate + entry_count > cap) {
+        disruptor->gate = _disruptor_min_gate(disruptor, w);
+    }
+    uint64_t room = cap - (w - disruptor->gate);
+    if (entry_count > room) {
+        entry_count = (size_t)room;
+    }
+    if (entry_count == 0) {
+        return 0;
+    }
+    size_t esize = disruptor->esz;
+    size_t byte_off = (size_t)(w & disruptor->mask) * esize;
+    size_t total_bytes = entry_count * esize;
+    size_t buf_size = (size_t)cap * esize;
+    size_t l = (total_bytes <= buf_size - byte_off) ? total_bytes
+                                                    : (buf_size - byte_off);
+
+    memcpy(disruptor->buf + byte_off, buf, l);
+    if (l < total_bytes) {
+        memcpy(disruptor->buf, (const char*)buf + l, total_bytes - l);
+    }
+    atomic_store_explicit(
+        &disruptor->cursor, w + entry_count, memory_order_release);
+
+    return entry_count;
+}
+
+size_t xylem_disruptor_poll(xylem_disruptor_consumer_t* consumer) {
+    uint64_t seq = atomic_load_explicit(&consumer->seq, memory_order_relaxed);
+    uint64_t limit = atomic_load_explicit(
+        &consumer->disruptor->cursor, memory_order_acquire);
+
+    for (size_t i = 0; i < consumer->ndeps; i++) {
+        uint64_t dep = atomic_load_explicit(
+            &consumer->deps[i]->seq, memory_order_acquire);
+        if (dep < limit) {
+            limit = dep;
+        }
+    }
+    if (limit < seq) {
+        limit = seq;
+    }
+    consumer->limit = limit;
+    return (size_t)(limit - seq);
+}
+
+void*
+xylem_disruptor_entry(xylem_disruptor_consumer_t* consumer, size_t index) {
+    uint64_t seq = atomic_load_explicit(&consumer->seq, memory_order_relaxed);
+    if (index >= consumer->limit - seq) {
+        return NULL;
+    }
+    xylem_disruptor_t* disruptor = consumer->disruptor;
+    size_t idx = (size_t)((seq + index) & disruptor->mask);
+
+    return disruptor->buf + idx * disruptor->esz;
+}
+
+void xylem_disruptor_release(
+    xylem_disruptor_consumer_t* consumer, size_t entry_count) {
+    uint64_t seq = atomic_load_explicit(&consumer->seq, memory_order_relaxed);
+    if (entry_count > consumer->limit - seq) {
+        entry_count = (size_t)(consumer->limit - seq);
+    }
+    atomic_store_explicit(
+        &consumer->seq, seq + entry_count, memory_order_release);
+}
+
+size_t xylem_disruptor_read(
+    xylem_disruptor_consumer_t* consumer, void* buf, size_t entry_count) {
+
+    size_t avail = xylem_disruptor_poll(consumer);
+    if (entry_count > avail) {
+        entry_count = avail;
+    }
+    if (entry_count == 0) {
+        return 0;
+    }
+    xylem_disruptor_t* disruptor = consumer->disruptor;
+    uint64_t seq = atomic_load_explicit(&consumer->seq, memory_order_relaxed);
+    size_t   esize = disruptor->esz;
+    size_t   byte_off = (size_t)(seq & disruptor->mask) * esize;
+    size_t   total_bytes = entry_count * esize;
+    size_t   buf_size = (size_t)(disruptor->mask + 1) * esize;
+    size_t   l = (total_bytes <= buf_size - byte_off) ? total_bytes
+                                                      : (buf_size - byte_off);
+
+    memcpy(buf, disruptor->buf + byte_off, l);
+    if (l < total_bytes) {
+        memcpy((char*)buf + l, disruptor->buf, total_bytes - l);
+    }
+    xylem_disruptor_release(consumer, entry_count);
+
+    return entry_count;
+}
\ No newline at end of file
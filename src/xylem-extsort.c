@@ -0,0 +1,503 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+
+#define EXTSORT_DEFAULT_MEMORY  ((size_t)256 << 20)
+#define EXTSORT_DEFAULT_THREADS 4
+#define EXTSORT_DEFAULT_IOSIZE  ((size_t)4 << 20)
+#define EXTSORT_NAME_TRIES      1000
+
+typedef struct extsort_s        extsort_t;
+typedef struct extsort_run_s    extsort_run_t;
+typedef struct extsort_chunk_s  extsort_chunk_t;
+typedef struct extsort_reader_s extsort_reader_t;
+
+struct extsort_s {
+    size_t            rsize;
+    size_t            memory;
+    size_t            nthreads;
+    size_t            iosize; /* whole records */
+    const char*       tmpdir;
+    unsigned          seq; /* temp file name counter */
+    xylem_thrdpool_t* pool;
+    extsort_run_t*    runs;
+    size_t            nruns;
+    size_t            cap;
+    int (*cmp)(const void* a, const void* b);
+};
+
+struct extsort_run_s {
+    FILE* fp;
+    char* name; /* NULL for tmpfile() runs */
+};
+
+/* one chunk of input, sorted and spilled by a pool thread. */
+struct extsort_chunk_s {
+    extsort_t*         sort;
+    char*              buf;
+    size_t             nrecs;
+    FILE*              fp;
+    bool               err;
+    xylem_waitgroup_t* wg;
+};
+
+/* double-buffered run reader: the merge consumes buf[cur] while the pool
+ * reads the next block into the other buffer.
+ */
+struct extsort_reader_s {
+    FILE*              fp;
+    char*              buf[2];
+    size_t             len[2];
+    size_t             cur;
+    size_t             pos;
+    size_t             iosize;
+    size_t             rsize;
+    bool               err;
+    xylem_thrdpool_t*  pool;
+    xylem_waitgroup_t* wg;
+};
+
+static int _extsort_run_open(extsort_t* sort, extsort_run_t* run) {
+    run->name = NULL;
+    if (!sort->tmpdir) {
+        run->fp = tmpfile();
+        return run->fp ? 0 : -1;
+    }
+    size_t len = strlen(sort->tmpdir) + 64;
+    run->name = malloc(len);
+    if (!run->name) {
+        return -1;
+    }
+    /* another sort, possibly in another process, may own the same name:
+     * create exclusively and move on to the next name on a clash.
+     */
+    for (int tries = 0; tries < EXTSORT_NAME_TRIES; tries++) {
+        snprintf(
+            run->name,
+            len,
+            "%s/xylem-extsort-%p-%u.run",
+            sort->tmpdir,
+            (void*)sort,
+            sort->seq++);
+        errno = 0;
+        run->fp = fopen(run->name, "w+bx");
+        if (run->fp) {
+            return 0;
+        }
+        if (errno != EEXIST) {
+            break;
+        }
+    }
+    free(run->name);
+    run->name = NULL;
+    return -1;
+}
+
+static void _extsort_run_close(extsort_run_t* run) {
+    if (run->fp) {
+        fclose(run->fp);
+    }
+    if (run->name) {
+        remove(run->name);
+        free(run->name);
+    }
+    run->fp = NULL;
+    run->name = NULL;
+}
+
+static extsort_run_t* _extsort_run_add(extsort_t* sort) {
+    if (sort->nruns == sort->cap) {
+        size_t         cap = sort->cap ? sort->cap * 2 : 16;
+        extsort_run_t* runs = realloc(sort->runs, cap * sizeof(extsort_run_t));
+        if (!runs) {
+            return NULL;
+        }
+        sort->runs = runs;
+        sort->cap = cap;
+    }
+    extsort_run_t* run = &sort->runs[sort->nruns];
+    if (_extsort_run_open(sort, run) != 0) {
+        return NULL;
+    }
+    sort->nruns++;
+    return run;
+}
+
+static void _extsort_chunk_job(void* arg) {
+    extsort_chunk_t* chunk = arg;
+    extsort_t*       sort = chunk->sort;
+
+    qsort(chunk->buf, chunk->nrecs, sort->rsize, sort->cmp);
+    if (fwrite(chunk->buf, sort->rsize, chunk->nrecs, chunk->fp) !=
+            chunk->nrecs ||
+        fflush(chunk->fp) != 0) {
+        chunk->err = true;
+    }
+    xylem_waitgroup_done(chunk->wg);
+}
+
+/* read up to `size` bytes; a trailing partial record is an error. */
+static int _extsort_read(
+    extsort_t* sort, FILE* fp, char* buf, size_t size, size_t* nrecs) {
+    size_t n = fread(buf, 1, size, fp);
+
+    if (ferror(fp) || n % sort->rsize != 0) {
+        return -1;
+    }
+    *nrecs = n / sort->rsize;
+    return 0;
+}
+
+/* size of a seekable input in bytes, or -1 for pipes and inputs too
+ * large for ftell().
+ */
+static long _extsort_input_size(FILE* fp) {
+    long size = -1;
+
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        size = ftell(fp);
+    }
+    if (fseek(fp, 0, SEEK_SET) != 0) {
+        return -1;
+    }
+    return size;
+}
+
+/* sort the input chunk by chunk, one chunk per pool thread per round. an
+ * input that fits in a single chunk is sorted straight into `out` and 0 is
+ * returned; 1 means the chunks were spilled as runs and need merging.
+ */
+static int _extsort_generate(extsort_t* sort, FILE* in, FILE* out) {
+    size_t             nchunks = sort->nthreads;
+    size_t             chunk_bytes = sort->memory / nchunks;
+    long               size = _extsort_input_size(in);
+    extsort_chunk_t*   chunks = NULL;
+    xylem_waitgroup_t* wg = xylem_waitgroup_create();
+    int                rc = -1;
+    bool               eof = false;
+
+    /* don't take the whole budget for a small input. one spare record
+     * lets a chunk that holds everything see the end of input, so it is
+     * sorted straight into `out`.
+     */
+    if (size >= 0 && chunk_bytes > (size_t)size + sort->rsize) {
+        chunk_bytes = (size_t)size + sort->rsize;
+    }
+    chunk_bytes -= chunk_bytes % sort->rsize;
+    if (chunk_bytes < sort->rsize) {
+        chunk_bytes = sort->rsize;
+    }
+    if (size >= 0 && nchunks > (size_t)size / chunk_bytes + 1) {
+        nchunks = (size_t)size / chunk_bytes + 1;
+    }
+    chunks = calloc(nchunks, sizeof(extsort_chunk_t));
+    if (!chunks || !wg) {
+        goto out;
+    }
+    for (size_t i = 0; i < nchunks; i++) {
+        chunks[i].sort = sort;
+        chunks[i].wg = wg;
+        chunks[i].buf = malloc(chunk_bytes);
+        if (!chunks[i].buf) {
+            goto out;
+        }
+    }
+    while (!eof) {
+        size_t posted = 0;
+
+        for (size_t i = 0; i < nchunks && !eof; i++) {
+            extsort_chunk_t* c = &chunks[i];
+            if (_extsort_read(sort, in, c->buf, chunk_bytes, &c->nrecs) != 0) {
+                goto wait;
+            }
+            eof = c->nrecs * sort->rsize < chunk_bytes;
+            if (eof && sort->nruns == 0 && i == 0) {
+                qsort(c->buf, c->nrecs, sort->rsize, sort->cmp);
+                if (fwrite(c->buf, sort->rsize, c->nrecs, out) == c->nrecs) {
+                    rc = 0;
+                }
+                goto out;
+            }
+            if (c->nrecs == 0) {
+                break;
+            }
+            extsort_run_t* run = _extsort_run_add(sort);
+            if (!run) {
+                goto wait;
+            }
+            c->fp = run->fp;
+            c->err = false;
+            xylem_waitgroup_add(wg, 1);
+            if (xylem_thrdpool_post(sort->pool, _extsort_chunk_job, c) != 0) {
+                _extsort_chunk_job(c);
+            }
+            posted++;
+        }
+        xylem_waitgroup_wait(wg);
+        for (size_t i = 0; i < posted; i++) {
+            if (chunks[i].err) {
+                goto out;
+            }
+        }
+    }
+    rc = 1;
+    goto out;
+
+wait:
+    xylem_waitgroup_wait(wg);
+out:
+    if (chunks) {
+        for (size_t i = 0; i < nchunks; i++) {
+            free(chunks[i].buf);
+        }
+    }
+    free(chunks);
+    xylem_waitgroup_destroy(wg);
+    return rc;
+}
+
+static void _extsort_prefetch_job(void* arg) {
+    extsort_reader_t* r = arg;
+    size_t            b = r->cur ^ 1;
+
+    r->len[b] = fread(r->buf[b], 1, r->iosize, r->fp);
+    if (ferror(r->fp)) {
+        r->err = true;
+        r->len[b] = 0;
+    }
+    xylem_waitgroup_done(r->wg);
+}
+
+static void _extsort_prefetch(extsort_reader_t* r) {
+    xylem_waitgroup_add(r->wg, 1);
+    /* run it inline if it cannot be queued, or the wait never returns. */
+    if (xylem_thrdpool_post(r->pool, _extsort_prefetch_job, r) != 0) {
+        _extsort_prefetch_job(r);
+    }
+}
+
+static size_t _extsort_refill(void* ctx, size_t run, void* buf, size_t cap) {
+    extsort_reader_t* r = (extsort_reader_t*)ctx + run;
+
+    if (r->pos == r->len[r->cur]) {
+        xylem_waitgroup_wait(r->wg);
+        if (r->len[r->cur ^ 1] == 0) {
+            return 0;
+        }
+        r->cur ^= 1;
+        r->pos = 0;
+        _extsort_prefetch(r);
+    }
+    size_t n = r->len[r->cur] - r->pos;
+    if (n > cap * r->rsize) {
+        n = cap * r->rsize;
+    }
+    memcpy(buf, r->buf[r->cur] + r->pos, n);
+    r->pos += n;
+    return n / r->rsize;
+}
+
+/* merge `n` runs into `out` through prefetching readers and a loser tree. */
+static int _extsort_merge(
+    extsort_t* sort, extsort_run_t* runs, size_t n, FILE* out) {
+    size_t            batch = sort->iosize / sort->rsize;
+    extsort_reader_t* readers = calloc(n, sizeof(extsort_reader_t));
+    char*             bufs = malloc(2 * n * sort->iosize);
+    char*             obuf = malloc(sort->iosize);
+    xylem_kmerge_t*   merge = NULL;
+    size_t            started = 0;
+    int               rc = -1;
+
+    if (!readers || !bufs || !obuf) {
+        goto out;
+    }
+    for (; started < n; started++) {
+        extsort_reader_t* r = &readers[started];
+        r->wg = xylem_waitgroup_create();
+        if (!r->wg) {
+            goto out;
+        }
+        r->fp = runs[started].fp;
+        r->buf[0] = bufs + 2 * started * sort->iosize;
+        r->buf[1] = r->buf[0] + sort->iosize;
+        r->iosize = sort->iosize;
+        r->rsize = sort->rsize;
+        r->pool = sort->pool;
+        rewind(r->fp);
+        /* block 0 is read by the first refill through the prefetch path. */
+        r->cur = 1;
+        _extsort_prefetch(r);
+    }
+    merge = xylem_kmerge_create(
+        n, sort->rsize, batch, sort->cmp, _extsort_refill, readers);
+    if (!merge) {
+        goto out;
+    }
+    for (;;) {
+        size_t got = xylem_kmerge_next(merge, obuf, batch);
+        if (got == 0) {
+            break;
+        }
+        if (fwrite(obuf, sort->rsize, got, out) != got) {
+            goto out;
+        }
+    }
+    rc = 0;
+
+out:
+    for (size_t i = 0; i < started; i++) {
+        xylem_waitgroup_wait(readers[i].wg);
+        if (readers[i].err) {
+            rc = -1;
+        }
+        xylem_waitgroup_destroy(readers[i].wg);
+    }
+    xylem_kmerge_destroy(merge);
+    free(obuf);
+    free(bufs);
+    free(readers);
+    return rc;
+}
+
+/* merge groups of `fanin` runs into new runs until one pass is enough. */
+static int _extsort_reduce(extsort_t* sort, size_t fanin) {
+    while (sort->nruns > fanin) {
+        extsort_run_t* old = sort->runs;
+        size_t         nold = sort->nruns;
+        size_t         done = 0;
+        int            rc = 0;
+
+        sort->runs = NULL;
+        sort->nruns = 0;
+        sort->cap = 0;
+        for (; done < nold && rc == 0; done += fanin) {
+            size_t         n = nold - done < fanin ? nold - done : fanin;
+            extsort_run_t* run = _extsort_run_add(sort);
+            if (!run) {
+                rc = -1;
+                break;
+            }
+            rc = _extsort_merge(sort, old + done, n, run->fp);
+            if (rc == 0 && fflush(run->fp) != 0) {
+                rc = -1;
+            }
+            for (size_t i = done; i < done + n; i++) {
+                _extsort_run_close(&old[i]);
+            }
+        }
+        for (size_t i = done; i < nold; i++) {
+            _extsort_run_close(&old[i]);
+        }
+        free(old);
+        if (rc != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int xylem_extsort_file(
+    const char* in,
+    const char* out,
+    size_t      rsize,
+    int (*cmp)(const void* a, const void* b),
+    const xylem_extsort_opts_t* opts) {
+    extsort_t sort = {0};
+    FILE*     fin = NULL;
+    FILE*     fout = NULL;
+    char*     tmp = NULL;
+    int       rc = -1;
+
+    if (!in || !out || rsize == 0 || !cmp) {
+        return -1;
+    }
+    /* `out` is only replaced, by renaming a temp file over it, once the
+     * sort succeeded, so a bad input, or `in` == `out`, leaves it intact.
+     */
+    fin = fopen(in, "rb");
+    if (!fin) {
+        return -1;
+    }
+    sort.rsize = rsize;
+    sort.cmp = cmp;
+    sort.memory = opts && opts->memory ? opts->memory : EXTSORT_DEFAULT_MEMORY;
+    sort.nthreads =
+        opts && opts->nthreads ? opts->nthreads : EXTSORT_DEFAULT_THREADS;
+    sort.iosize = opts && opts->iosize ? opts->iosize : EXTSORT_DEFAULT_IOSIZE;
+    sort.tmpdir = opts ? opts->tmpdir : NULL;
+    sort.iosize -= sort.iosize % rsize;
+    if (sort.iosize < rsize) {
+        sort.iosize = rsize;
+    }
+    /* each merged run holds two read buffers plus the loser tree's batch. */
+    size_t fanin = sort.memory / (3 * sort.iosize);
+    if (fanin < 2) {
+        fanin = 2;
+    }
+    sort.pool = xylem_thrdpool_create((int)sort.nthreads);
+    tmp = malloc(strlen(out) + sizeof(".xylem-extsort.tmp"));
+    if (!sort.pool || !tmp) {
+        goto out;
+    }
+    strcpy(tmp, out);
+    strcat(tmp, ".xylem-extsort.tmp");
+    fout = fopen(tmp, "wb");
+    if (!fout) {
+        goto out;
+    }
+    rc = _extsort_generate(&sort, fin, fout);
+    if (rc == 1) {
+        rc = _extsort_reduce(&sort, fanin);
+        if (rc == 0) {
+            rc = _extsort_merge(&sort, sort.runs, sort.nruns, fout);
+        }
+    }
+
+out:
+    for (size_t i = 0; i < sort.nruns; i++) {
+        _extsort_run_close(&sort.runs[i]);
+    }
+    free(sort.runs);
+    if (sort.pool) {
+        xylem_thrdpool_destroy(sort.pool);
+    }
+    fclose(fin);
+    if (fout) {
+        if (fclose(fout) != 0) {
+            rc = -1;
+        }
+#if defined(_WIN32)
+        /* rename() does not replace an existing file on Windows. */
+        if (rc == 0) {
+            remove(out);
+        }
+#endif
+        if (rc == 0 && rename(tmp, out) != 0) {
+            rc = -1;
+        }
+        if (rc != 0) {
+            remove(tmp);
+        }
+    }
+    free(tmp);
+    return rc;
+}
\ No newline at end of file
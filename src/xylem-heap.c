@@ -20,40 +20,29 @@
  */
 
 #include "xylem.h"
+#include "platform/platform.h"
 
-/* swap parent with child. child moves closer to the root, parent moves away. */
-static void _heap_node_swap(
-    xylem_heap_t* heap, xylem_heap_node_t* parent, xylem_heap_node_t* child) {
-    xylem_heap_node_t* sibling;
-    xylem_heap_node_t  t;
+static void _heap_sift_up(xylem_heap_t* heap, xylem_heap_node_t* node) {
+    while (node->parent != NULL && heap->cmp(node, node->parent) < 0) {
+        xylem_heap_node_swap(heap, node->parent, node);
+    }
+}
 
-    t = *parent;
-    *parent = *child;
-    *child = t;
+static void _heap_sift_down(xylem_heap_t* heap, xylem_heap_node_t* node) {
+    xylem_heap_node_t* smallest;
 
-    parent->parent = child;
-    if (child->left == child) {
-        child->left = parent;
-        sibling = child->right;
-    } else {
-        child->right = parent;
-        sibling = child->left;
-    }
-    if (sibling != NULL) {
-        sibling->parent = child;
-    }
-    if (parent->left != NULL) {
-        parent->left->parent = parent;
-    }
-    if (parent->right != NULL) {
-        parent->right->parent = parent;
-    }
-    if (child->parent == NULL) {
-        heap->root = child;
-    } else if (child->parent->left == parent) {
-        child->parent->left = child;
-    } else {
-        child->parent->right = child;
+    for (;;) {
+        smallest = node;
+        if (node->left != NULL && heap->cmp(node->left, smallest) < 0) {
+            smallest = node->left;
+        }
+        if (node->right != NULL && heap->cmp(node->right, smallest) < 0) {
+            smallest = node->right;
+        }
+        if (smallest == node) {
+            break;
+        }
+        xylem_heap_node_swap(heap, node, smallest);
     }
 }
 
@@ -66,8 +55,7 @@ void xylem_heap_init(
     heap->cmp = cmp;
 }
 
-void
-xylem_heap_insert(xylem_heap_t* heap, xylem_heap_node_t* node) {
+void xylem_heap_link(xylem_heap_t* heap, xylem_heap_node_t* node) {
     xylem_heap_node_t** parent;
     xylem_heap_node_t** child;
     size_t              path;
@@ -102,16 +90,18 @@ xylem_heap_insert(xylem_heap_t* heap, xylem_heap_node_t* node) {
     node->parent = *parent;
     *child = node;
     heap->nelts += 1;
+}
+
+void xylem_heap_insert(xylem_heap_t* heap, xylem_heap_node_t* node) {
+    xylem_heap_link(heap, node);
     /* walk up the tree and check at each node if the heap property holds.
      * it's a min heap so parent < child must be true.
      */
-    while (node->parent != NULL && heap->cmp(node, node->parent) < 0) {
-        _heap_node_swap(heap, node->parent, node);
-    }
+    _heap_sift_up(heap, node);
 }
 
-void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node) {
-    xylem_heap_node_t*  smallest;
+xylem_heap_node_t*
+xylem_heap_unlink(xylem_heap_t* heap, xylem_heap_node_t* node) {
     xylem_heap_node_t** max;
     xylem_heap_node_t*  child;
     size_t              path;
@@ -119,7 +109,7 @@ void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node) {
     size_t              n;
 
     if (heap->nelts == 0) {
-        return;
+        return NULL;
     }
     /* calculate the path from the min (the root) to the max, the left-most node
      * of the bottom row.
@@ -151,7 +141,7 @@ void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node) {
         if (child == heap->root) {
             heap->root = NULL;
         }
-        return;
+        return NULL;
     }
     /* replace the to be deleted node with the max node. */
     child->left = node->left;
@@ -171,29 +161,32 @@ void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node) {
     } else {
         node->parent->right = child;
     }
+    return child;
+}
+
+void xylem_heap_remove(xylem_heap_t* heap, xylem_heap_node_t* node) {
+    xylem_heap_node_t* child = xylem_heap_unlink(heap, node);
+
+    if (child == NULL) {
+        return;
+    }
     /* walk down the subtree and check at each node if the heap property holds.
      * it's a min heap so parent < child must be true.  if the parent is bigger,
      * swap it with the smallest child.
      */
-    for (;;) {
-        smallest = child;
-        if (child->left != NULL && heap->cmp(child->left, smallest) < 0) {
-            smallest = child->left;
-        }
-        if (child->right != NULL && heap->cmp(child->right, smallest) < 0) {
-            smallest = child->right;
-        }
-        if (smallest == child) {
-            break;
-        }
-        _heap_node_swap(heap, child, smallest);
-    }
+    _heap_sift_down(heap, child);
     /* walk up the subtree and check that each parent is less than the node
      * this is required, because `max` node is not guaranteed to be the
      * actual maximum in tree
      */
-    while (child->parent != NULL && heap->cmp(child, child->parent) < 0) {
-        _heap_node_swap(heap, child->parent, child);
+    _heap_sift_up(heap, child);
+}
+
+void xylem_heap_update(xylem_heap_t* heap, xylem_heap_node_t* node) {
+    if (node->parent != NULL && heap->cmp(node, node->parent) < 0) {
+        _heap_sift_up(heap, node);
+    } else {
+        _heap_sift_down(heap, node);
     }
 }
 
@@ -207,4 +200,444 @@ bool xylem_heap_empty(xylem_heap_t* heap) {
 
 xylem_heap_node_t* xylem_heap_root(xylem_heap_t* heap) {
     return heap->root;
+}
+
+/* floyd heapify over an array of nodes laid out in level order, then link
+ * the array into the tree shape: slot i has children 2i+1 and 2i+2.
+ */
+void xylem_heap_build(
+    xylem_heap_t* heap, xylem_heap_node_t** nodes, size_t n) {
+    for (size_t i = n / 2; i-- > 0;) {
+        xylem_heap_node_t* t = nodes[i];
+        size_t             k = i;
+
+        for (;;) {
+            size_t c = 2 * k + 1;
+            if (c >= n) {
+                break;
+            }
+            if (c + 1 < n && heap->cmp(nodes[c + 1], nodes[c]) < 0) {
+                c += 1;
+            }
+            if (heap->cmp(nodes[c], t) >= 0) {
+                break;
+            }
+            nodes[k] = nodes[c];
+            k = c;
+        }
+        nodes[k] = t;
+    }
+    for (size_t i = 0; i < n; i++) {
+        nodes[i]->parent = i ? nodes[(i - 1) / 2] : NULL;
+        nodes[i]->left = 2 * i + 1 < n ? nodes[2 * i + 1] : NULL;
+        nodes[i]->right = 2 * i + 2 < n ? nodes[2 * i + 2] : NULL;
+    }
+    heap->root = n ? nodes[0] : NULL;
+    heap->nelts = n;
+}
+
+void xylem_heap_insert_batch(
+    xylem_heap_t* heap, xylem_heap_node_t** nodes, size_t n) {
+    xylem_heap_node_t** all = NULL;
+    size_t              total = heap->nelts + n;
+    size_t              depth = 0;
+
+    /* a rebuild costs O(total), individual inserts O(n log total). */
+    for (size_t t = total; t > 1; t >>= 1) {
+        depth += 1;
+    }
+    if (n * depth > total) {
+        all = malloc(total * sizeof(xylem_heap_node_t*));
+    }
+    if (!all) {
+        for (size_t i = 0; i < n; i++) {
+            xylem_heap_insert(heap, nodes[i]);
+        }
+        return;
+    }
+    /* the tree is complete, so its level order is its array layout. */
+    size_t len = 0;
+    if (heap->root) {
+        all[len++] = heap->root;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (all[i]->left) {
+            all[len++] = all[i]->left;
+        }
+        if (all[i]->right) {
+            all[len++] = all[i]->right;
+        }
+    }
+    memcpy(all + len, nodes, n * sizeof(xylem_heap_node_t*));
+    xylem_heap_build(heap, all, total);
+    free(all);
+}
+
+#define DHEAP_MIN_CAP 64
+
+/* move the slot at `index` towards the root until its parent is not larger.
+ * the hole technique writes each displaced slot once.
+ */
+static void _dheap_sift_up(xylem_dheap_t* heap, size_t index) {
+    xylem_dheap_slot_t* slots = heap->slots;
+    xylem_dheap_slot_t  s = slots[index];
+
+    while (index > 0) {
+        size_t parent = (index - 1) / heap->d;
+        if (slots[parent].key <= s.key) {
+            break;
+        }
+        slots[index] = slots[parent];
+        slots[index].node->index = index;
+        index = parent;
+    }
+    slots[index] = s;
+    s.node->index = index;
+}
+
+/* move the slot at `index` away from the root until no child is smaller. */
+static void _dheap_sift_down(xylem_dheap_t* heap, size_t index) {
+    xylem_dheap_slot_t* slots = heap->slots;
+    xylem_dheap_slot_t  s = slots[index];
+    size_t              d = heap->d;
+    size_t              n = heap->nelts;
+
+    for (;;) {
+        size_t first = index * d + 1;
+        if (first >= n) {
+            break;
+        }
+        size_t last = first + d < n ? first + d : n;
+        size_t smallest = first;
+        for (size_t i = first + 1; i < last; i++) {
+            if (slots[i].key < slots[smallest].key) {
+                smallest = i;
+            }
+        }
+        if (slots[smallest].key >= s.key) {
+            break;
+        }
+        slots[index] = slots[smallest];
+        slots[index].node->index = index;
+        index = smallest;
+    }
+    slots[index] = s;
+    s.node->index = index;
+}
+
+void xylem_dheap_init(xylem_dheap_t* heap, size_t d) {
+    heap->slots = NULL;
+    heap->nelts = 0;
+    heap->cap = 0;
+    heap->d = d < 2 ? 2 : d;
+}
+
+void xylem_dheap_deinit(xylem_dheap_t* heap) {
+    free(heap->slots);
+    heap->slots = NULL;
+    heap->nelts = 0;
+    heap->cap = 0;
+}
+
+int xylem_dheap_insert(
+    xylem_dheap_t* heap, xylem_dheap_node_t* node, uint64_t key) {
+    if (heap->nelts == heap->cap) {
+        size_t cap = heap->cap ? heap->cap * 2 : DHEAP_MIN_CAP;
+        xylem_dheap_slot_t* slots =
+            realloc(heap->slots, cap * sizeof(xylem_dheap_slot_t));
+        if (!slots) {
+            return -1;
+        }
+        heap->slots = slots;
+        heap->cap = cap;
+    }
+    heap->slots[heap->nelts].key = key;
+    heap->slots[heap->nelts].node = node;
+    heap->nelts += 1;
+    _dheap_sift_up(heap, heap->nelts - 1);
+    return 0;
+}
+
+void xylem_dheap_remove(xylem_dheap_t* heap, xylem_dheap_node_t* node) {
+    size_t index = node->index;
+
+    if (heap->nelts == 0) {
+        return;
+    }
+    heap->nelts -= 1;
+    if (index == heap->nelts) {
+        return;
+    }
+    /* fill the hole with the last slot, which may need to move either way. */
+    heap->slots[index] = heap->slots[heap->nelts];
+    if (index > 0 &&
+        heap->slots[index].key < heap->slots[(index - 1) / heap->d].key) {
+        _dheap_sift_up(heap, index);
+    } else {
+        _dheap_sift_down(heap, index);
+    }
+}
+
+void xylem_dheap_update(
+    xylem_dheap_t* heap, xylem_dheap_node_t* node, uint64_t key) {
+    size_t index = node->index;
+
+    heap->slots[index].key = key;
+    if (index > 0 && key < heap->slots[(index - 1) / heap->d].key) {
+        _dheap_sift_up(heap, index);
+    } else {
+        _dheap_sift_down(heap, index);
+    }
+}
+
+void xylem_dheap_dequeue(xylem_dheap_t* heap) {
+    if (heap->nelts > 0) {
+        xylem_dheap_remove(heap, heap->slots[0].node);
+    }
+}
+
+bool xylem_dheap_empty(xylem_dheap_t* heap) {
+    return heap->nelts == 0;
+}
+
+xylem_dheap_node_t* xylem_dheap_root(xylem_dheap_t* heap) {
+    return heap->nelts ? heap->slots[0].node : NULL;
+}
+
+uint64_t xylem_dheap_key(xylem_dheap_t* heap, xylem_dheap_node_t* node) {
+    return heap->slots[node->index].key;
+}
+
+static void _rheap_link(
+    xylem_rheap_t* heap, xylem_rheap_node_t* node, size_t bucket) {
+    node->bucket = bucket;
+    node->prev = NULL;
+    node->next = heap->buckets[bucket];
+    if (node->next) {
+        node->next->prev = node;
+    }
+    heap->buckets[bucket] = node;
+    if (bucket > 0) {
+        uint64_t bit = (uint64_t)1 << (bucket - 1);
+        if (!(heap->mask & bit) || node->key < heap->mins[bucket]) {
+            heap->mins[bucket] = node->key;
+        }
+        heap->mask |= bit;
+    }
+}
+
+static void _rheap_unlink(xylem_rheap_t* heap, xylem_rheap_node_t* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        heap->buckets[node->bucket] = node->next;
+        if (!node->next && node->bucket > 0) {
+            heap->mask &= ~((uint64_t)1 << (node->bucket - 1));
+        }
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+}
+
+static size_t _rheap_bucket(xylem_rheap_t* heap, uint64_t key) {
+    if (key <= heap->last) {
+        return 0;
+    }
+    return 64 - (size_t)platform_clz64(key ^ heap->last);
+}
+
+/* when bucket 0 runs dry, advance `last` to the lowest non-empty bucket's
+ * minimum and spread that bucket over the lower ones. the recorded minimum
+ * may belong to a removed node; it is still a lower bound sharing the
+ * bucket's prefix, so the spread stays correct and we just go again.
+ */
+static void _rheap_refill(xylem_rheap_t* heap) {
+    while (!heap->buckets[0] && heap->mask) {
+        size_t              b = (size_t)platform_ctz64(heap->mask) + 1;
+        xylem_rheap_node_t* list = heap->buckets[b];
+
+        heap->buckets[b] = NULL;
+        heap->mask &= ~((uint64_t)1 << (b - 1));
+        heap->last = heap->mins[b];
+
+        while (list) {
+            xylem_rheap_node_t* next = list->next;
+            _rheap_link(heap, list, _rheap_bucket(heap, list->key));
+            list = next;
+        }
+    }
+}
+
+void xylem_rheap_init(xylem_rheap_t* heap) {
+    memset(heap->buckets, 0, sizeof(heap->buckets));
+    memset(heap->mins, 0, sizeof(heap->mins));
+    heap->mask = 0;
+    heap->last = 0;
+    heap->nelts = 0;
+}
+
+void xylem_rheap_insert(
+    xylem_rheap_t* heap, xylem_rheap_node_t* node, uint64_t key) {
+    node->key = key;
+    _rheap_link(heap, node, _rheap_bucket(heap, key));
+    heap->nelts += 1;
+}
+
+void xylem_rheap_remove(xylem_rheap_t* heap, xylem_rheap_node_t* node) {
+    _rheap_unlink(heap, node);
+    heap->nelts -= 1;
+}
+
+void xylem_rheap_dequeue(xylem_rheap_t* heap) {
+    xylem_rheap_node_t* root = xylem_rheap_root(heap);
+
+    if (root) {
+        xylem_rheap_remove(heap, root);
+    }
+}
+
+bool xylem_rheap_empty(xylem_rheap_t* heap) {
+    return heap->nelts == 0;
+}
+
+xylem_rheap_node_t* xylem_rheap_root(xylem_rheap_t* heap) {
+    _rheap_refill(heap);
+    return heap->buckets[0];
+}
+
+uint64_t xylem_rheap_last(xylem_rheap_t* heap) {
+    return heap->last;
+}
+
+/* link two roots; the loser becomes the winner's first child. */
+static xylem_pheap_node_t* _pheap_link(
+    xylem_pheap_t* heap, xylem_pheap_node_t* a, xylem_pheap_node_t* b) {
+    if (heap->cmp(b, a) < 0) {
+        xylem_pheap_node_t* t = a;
+        a = b;
+        b = t;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    a->next = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+/* two-pass pairing: link siblings pairwise left to right, then fold the
+ * pairs right to left into a single tree.
+ */
+static xylem_pheap_node_t* _pheap_merge_pairs(
+    xylem_pheap_t* heap, xylem_pheap_node_t* first) {
+    xylem_pheap_node_t* pairs = NULL;
+
+    while (first) {
+        xylem_pheap_node_t* a = first;
+        xylem_pheap_node_t* b = a->next;
+        xylem_pheap_node_t* m;
+
+        if (b) {
+            first = b->next;
+            m = _pheap_link(heap, a, b);
+        } else {
+            first = NULL;
+            m = a;
+            m->prev = NULL;
+        }
+        m->next = pairs;
+        pairs = m;
+    }
+    if (!pairs) {
+        return NULL;
+    }
+    xylem_pheap_node_t* root = pairs;
+    pairs = pairs->next;
+    root->next = NULL;
+    while (pairs) {
+        xylem_pheap_node_t* next = pairs->next;
+        root = _pheap_link(heap, root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+static void _pheap_detach(xylem_pheap_node_t* node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+void xylem_pheap_init(
+    xylem_pheap_t* heap,
+    int (*cmp)(const xylem_pheap_node_t* a, const xylem_pheap_node_t* b)) {
+    heap->root = NULL;
+    heap->nelts = 0;
+    heap->cmp = cmp;
+}
+
+void xylem_pheap_insert(xylem_pheap_t* heap, xylem_pheap_node_t* node) {
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    heap->root = heap->root ? _pheap_link(heap, heap->root, node) : node;
+    heap->nelts += 1;
+}
+
+void xylem_pheap_remove(xylem_pheap_t* heap, xylem_pheap_node_t* node) {
+    if (node == heap->root) {
+        heap->root = _pheap_merge_pairs(heap, node->child);
+    } else {
+        _pheap_detach(node);
+        xylem_pheap_node_t* sub = _pheap_merge_pairs(heap, node->child);
+        if (sub) {
+            heap->root = _pheap_link(heap, heap->root, sub);
+        }
+    }
+    node->child = NULL;
+    heap->nelts -= 1;
+}
+
+void xylem_pheap_dequeue(xylem_pheap_t* heap) {
+    if (heap->root) {
+        xylem_pheap_remove(heap, heap->root);
+    }
+}
+
+bool xylem_pheap_empty(xylem_pheap_t* heap) {
+    return heap->root == NULL;
+}
+
+xylem_pheap_node_t* xylem_pheap_root(xylem_pheap_t* heap) {
+    return heap->root;
+}
+
+void xylem_pheap_meld(xylem_pheap_t* heap, xylem_pheap_t* other) {
+    if (!other->root) {
+        return;
+    }
+    heap->root = heap->root ? _pheap_link(heap, heap->root, other->root)
+                            : other->root;
+    heap->nelts += other->nelts;
+    other->root = NULL;
+    other->nelts = 0;
+}
+
+void xylem_pheap_decrease(xylem_pheap_t* heap, xylem_pheap_node_t* node) {
+    if (node == heap->root) {
+        return;
+    }
+    _pheap_detach(node);
+    heap->root = _pheap_link(heap, heap->root, node);
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+
+#define ITREE_NODE(n)                                                          \
+    xylem_rbtree_entry(n, xylem_itree_node_t, rb)
+
+/* order by lo, then by address so equal intervals are all kept. */
+static int
+_itree_cmp_nn(const xylem_rbtree_node_t* a, const xylem_rbtree_node_t* b) {
+    const xylem_itree_node_t* x = ITREE_NODE(a);
+    const xylem_itree_node_t* y = ITREE_NODE(b);
+
+    if (x->lo != y->lo) {
+        return x->lo < y->lo ? -1 : 1;
+    }
+    return (uintptr_t)x < (uintptr_t)y ? -1 : (uintptr_t)x > (uintptr_t)y;
+}
+
+static int _itree_cmp_kn(const void* key, const xylem_rbtree_node_t* node) {
+    uint64_t k = *(const uint64_t*)key;
+    uint64_t lo = ITREE_NODE(node)->lo;
+
+    return k < lo ? -1 : k > lo;
+}
+
+static void _itree_augment(xylem_rbtree_node_t* node) {
+    xylem_itree_node_t* n = ITREE_NODE(node);
+    uint64_t            max = n->hi;
+
+    if (node->left && ITREE_NODE(node->left)->max > max) {
+        max = ITREE_NODE(node->left)->max;
+    }
+    if (node->right && ITREE_NODE(node->right)->max > max) {
+        max = ITREE_NODE(node->right)->max;
+    }
+    n->max = max;
+}
+
+/* leftmost node in the subtree of `node` overlapping [lo, last]. */
+static xylem_itree_node_t*
+_itree_subtree_search(xylem_rbtree_node_t* node, uint64_t lo, uint64_t last) {
+    for (;;) {
+        xylem_itree_node_t* n = ITREE_NODE(node);
+
+        if (node->left && ITREE_NODE(node->left)->max > lo) {
+            node = node->left;
+            continue;
+        }
+        if (n->lo > last) {
+            return NULL;
+        }
+        if (n->hi > lo) {
+            return n;
+        }
+        if (node->right && ITREE_NODE(node->right)->max > lo) {
+            node = node->right;
+            continue;
+        }
+        return NULL;
+    }
+}
+
+/* in-order successor of `n` overlapping [lo, last]. */
+static xylem_itree_node_t*
+_itree_next(xylem_itree_node_t* n, uint64_t lo, uint64_t last) {
+    xylem_rbtree_node_t* node = &n->rb;
+    xylem_rbtree_node_t* right = node->right;
+    xylem_rbtree_node_t* prev;
+
+    for (;;) {
+        /* every later node outside the right subtree starts after it, so
+         * if the right subtree reaches `lo` the answer is in there or
+         * nowhere.
+         */
+        if (right && ITREE_NODE(right)->max > lo) {
+            return _itree_subtree_search(right, lo, last);
+        }
+        do {
+            prev = node;
+            node = xylem_rbtree_parent(node);
+            if (!node) {
+                return NULL;
+            }
+            right = node->right;
+        } while (prev == right);
+
+        n = ITREE_NODE(node);
+        if (n->lo > last) {
+            return NULL;
+        }
+        if (n->hi > lo) {
+            return n;
+        }
+    }
+}
+
+void xylem_itree_init(xylem_itree_t* itree) {
+    xylem_rbtree_init_augmented(
+        &itree->tree, _itree_cmp_nn, _itree_cmp_kn, _itree_augment);
+}
+
+void xylem_itree_insert(
+    xylem_itree_t* itree, xylem_itree_node_t* node, uint64_t lo, uint64_t hi) {
+    node->lo = lo;
+    node->hi = hi;
+    node->max = hi;
+    xylem_rbtree_insert(&itree->tree, &node->rb);
+}
+
+void xylem_itree_erase(xylem_itree_t* itree, xylem_itree_node_t* node) {
+    xylem_rbtree_erase(&itree->tree, &node->rb);
+}
+
+bool xylem_itree_empty(xylem_itree_t* itree) {
+    return xylem_rbtree_empty(&itree->tree);
+}
+
+static void _itree_iter_init(
+    xylem_itree_iter_t* iter,
+    xylem_itree_t*      itree,
+    uint64_t            lo,
+    uint64_t            last) {
+    xylem_rbtree_node_t* root = itree->tree.root;
+
+    iter->lo = lo;
+    iter->last = last;
+    iter->next = NULL;
+    if (root && ITREE_NODE(root)->max > lo &&
+        ITREE_NODE(itree->tree.leftmost)->lo <= last) {
+        iter->next = _itree_subtree_search(root, lo, last);
+    }
+}
+
+void xylem_itree_overlap_init(
+    xylem_itree_iter_t* iter, xylem_itree_t* itree, uint64_t lo, uint64_t hi) {
+    if (hi <= lo) {
+        iter->next = NULL;
+        return;
+    }
+    _itree_iter_init(iter, itree, lo, hi - 1);
+}
+
+void xylem_itree_stab_init(
+    xylem_itree_iter_t* iter, xylem_itree_t* itree, uint64_t point) {
+    _itree_iter_init(iter, itree, point, point);
+}
+
+xylem_itree_node_t* xylem_itree_iter_next(xylem_itree_iter_t* iter) {
+    xylem_itree_node_t* node = iter->next;
+
+    if (node) {
+        iter->next = _itree_next(node, iter->lo, iter->last);
+    }
+    return node;
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+
+typedef struct kmerge_run_s {
+    char*  buf;
+    size_t pos;
+    size_t len;
+    bool   done;
+} kmerge_run_t;
+
+struct xylem_kmerge_s {
+    kmerge_run_t*          runs;
+    size_t*                tree; /* tree[0] is the winner, others losers */
+    size_t                 k;
+    size_t                 esz;
+    size_t                 batch;
+    int (*cmp)(const void* a, const void* b);
+    xylem_kmerge_refill_fn refill;
+    void*                  ctx;
+};
+
+static void _kmerge_fill(xylem_kmerge_t* merge, size_t i) {
+    kmerge_run_t* run = &merge->runs[i];
+
+    run->pos = 0;
+    run->len = merge->refill(merge->ctx, i, run->buf, merge->batch);
+    run->done = run->len == 0;
+}
+
+static const void* _kmerge_head(xylem_kmerge_t* merge, size_t i) {
+    kmerge_run_t* run = &merge->runs[i];
+    return run->buf + run->pos * merge->esz;
+}
+
+/* does run a's head come before run b's? exhausted runs lose, ties go to
+ * the lower run index so the merge is stable.
+ */
+static bool _kmerge_beats(xylem_kmerge_t* merge, size_t a, size_t b) {
+    if (merge->runs[a].done) {
+        return false;
+    }
+    if (merge->runs[b].done) {
+        return true;
+    }
+    int c = merge->cmp(_kmerge_head(merge, a), _kmerge_head(merge, b));
+    return c < 0 || (c == 0 && a < b);
+}
+
+/* leaves sit at positions k..2k-1; play the winner of leaf `i` back up. */
+static void _kmerge_replay(xylem_kmerge_t* merge, size_t i) {
+    size_t* tree = merge->tree;
+    size_t  w = i;
+
+    for (size_t p = (merge->k + i) / 2; p > 0; p /= 2) {
+        if (_kmerge_beats(merge, tree[p], w)) {
+            size_t t = tree[p];
+            tree[p] = w;
+            w = t;
+        }
+    }
+    tree[0] = w;
+}
+
+xylem_kmerge_t* xylem_kmerge_create(
+    size_t k,
+    size_t esize,
+    size_t batch,
+    int (*cmp)(const void* a, const void* b),
+    xylem_kmerge_refill_fn refill,
+    void*                  ctx) {
+    if (k == 0 || esize == 0 || batch == 0 || !cmp || !refill ||
+        batch > SIZE_MAX / esize / k) {
+        return NULL;
+    }
+    xylem_kmerge_t* merge = malloc(sizeof(xylem_kmerge_t));
+    if (!merge) {
+        return NULL;
+    }
+    merge->runs = malloc(k * sizeof(kmerge_run_t));
+    merge->tree = malloc(2 * k * sizeof(size_t));
+    char* bufs = malloc(k * batch * esize);
+    if (!merge->runs || !merge->tree || !bufs) {
+        free(bufs);
+        free(merge->tree);
+        free(merge->runs);
+        free(merge);
+        return NULL;
+    }
+    merge->k = k;
+    merge->esz = esize;
+    merge->batch = batch;
+    merge->cmp = cmp;
+    merge->refill = refill;
+    merge->ctx = ctx;
+
+    for (size_t i = 0; i < k; i++) {
+        merge->runs[i].buf = bufs + i * batch * esize;
+        _kmerge_fill(merge, i);
+    }
+    /* build bottom-up. losers go to tree[1..k-1]; the winner of internal
+     * node p is parked in tree[k + p] until its parent has played, and
+     * leaf c >= k is run c - k.
+     */
+    size_t* tree = merge->tree;
+    for (size_t p = k - 1; p > 0; p--) {
+        size_t a = 2 * p >= k ? 2 * p - k : tree[k + 2 * p];
+        size_t b = 2 * p + 1 >= k ? 2 * p + 1 - k : tree[k + 2 * p + 1];
+        if (_kmerge_beats(merge, a, b)) {
+            tree[p] = b;
+            tree[k + p] = a;
+        } else {
+            tree[p] = a;
+            tree[k + p] = b;
+        }
+    }
+    tree[0] = k > 1 ? tree[k + 1] : 0;
+    return merge;
+}
+
+void xylem_kmerge_destroy(xylem_kmerge_t* merge) {
+    if (!merge) {
+        return;
+    }
+    free(merge->runs[0].buf);
+    free(merge->tree);
+    free(merge->runs);
+    free(merge);
+}
+
+size_t xylem_kmerge_next(xylem_kmerge_t* merge, void* out, size_t n) {
+    char*  dst = out;
+    size_t count = 0;
+
+    while (count < n) {
+        size_t        w = merge->tree[0];
+        kmerge_run_t* run = &merge->runs[w];
+
+        if (run->done) {
+            break;
+        }
+        memcpy(dst, _kmerge_head(merge, w), merge->esz);
+        dst += merge->esz;
+        count++;
+        if (++run->pos == run->len) {
+            _kmerge_fill(merge, w);
+        }
+        _kmerge_replay(merge, w);
+    }
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "platform/platform.h"
+
+#define MULTIQUEUE_CACHELINE 64
+#define MULTIQUEUE_EMPTY     UINT64_MAX
+
+typedef struct multiqueue_heap_s {
+    _Atomic bool     locked;
+    _Atomic uint64_t top; /* root key or UINT64_MAX, read unlocked as a hint */
+    xylem_dheap_t    heap;
+} multiqueue_heap_t;
+
+/* keep each heap's lock and top on its own cache lines. */
+typedef union multiqueue_slot_u {
+    multiqueue_heap_t q;
+    char              pad[2 * MULTIQUEUE_CACHELINE];
+} multiqueue_slot_t;
+
+struct xylem_multiqueue_s {
+    _Atomic size_t     nelts;
+    size_t             nheaps;
+    multiqueue_slot_t* slots;
+};
+
+static thread_local uint64_t _multiqueue_seed;
+
+static size_t _multiqueue_rand(size_t n) {
+    uint64_t x = _multiqueue_seed;
+
+    if (x == 0) {
+        x = (uint64_t)(uintptr_t)&_multiqueue_seed | 1;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    _multiqueue_seed = x;
+    return (size_t)((x * 2685821657736338717ull) >> 32) % n;
+}
+
+static bool _multiqueue_trylock(multiqueue_heap_t* q) {
+    return !atomic_load_explicit(&q->locked, memory_order_relaxed) &&
+           !atomic_exchange_explicit(&q->locked, true, memory_order_acquire);
+}
+
+static void _multiqueue_unlock(multiqueue_heap_t* q) {
+    uint64_t top = MULTIQUEUE_EMPTY;
+
+    if (!xylem_dheap_empty(&q->heap)) {
+        top = q->heap.slots[0].key;
+    }
+    atomic_store_explicit(&q->top, top, memory_order_relaxed);
+    atomic_store_explicit(&q->locked, false, memory_order_release);
+}
+
+/* back off after a full round of failed attempts. */
+static void _multiqueue_backoff(xylem_multiqueue_t* mq, size_t* tries) {
+    if (++*tries % mq->nheaps == 0) {
+        thrd_yield();
+    } else {
+        platform_cpu_relax();
+    }
+}
+
+xylem_multiqueue_t* xylem_multiqueue_create(size_t nheaps) {
+    if (nheaps < 2) {
+        nheaps = 2;
+    }
+    xylem_multiqueue_t* mq = malloc(sizeof(xylem_multiqueue_t));
+    if (!mq) {
+        return NULL;
+    }
+    mq->slots = malloc(nheaps * sizeof(multiqueue_slot_t));
+    if (!mq->slots) {
+        free(mq);
+        return NULL;
+    }
+    for (size_t i = 0; i < nheaps; i++) {
+        multiqueue_heap_t* q = &mq->slots[i].q;
+        atomic_init(&q->locked, false);
+        atomic_init(&q->top, MULTIQUEUE_EMPTY);
+        xylem_dheap_init(&q->heap, 4);
+    }
+    atomic_init(&mq->nelts, 0);
+    mq->nheaps = nheaps;
+    return mq;
+}
+
+void xylem_multiqueue_destroy(xylem_multiqueue_t* mq) {
+    if (!mq) {
+        return;
+    }
+    for (size_t i = 0; i < mq->nheaps; i++) {
+        xylem_dheap_deinit(&mq->slots[i].q.heap);
+    }
+    free(mq->slots);
+    free(mq);
+}
+
+int xylem_multiqueue_push(
+    xylem_multiqueue_t* mq, xylem_multiqueue_node_t* node, uint64_t key) {
+    size_t tries = 0;
+
+    for (;;) {
+        multiqueue_heap_t* q = &mq->slots[_multiqueue_rand(mq->nheaps)].q;
+        if (!_multiqueue_trylock(q)) {
+            _multiqueue_backoff(mq, &tries);
+            continue;
+        }
+        int rc = xylem_dheap_insert(&q->heap, &node->heap, key);
+        if (rc == 0) {
+            atomic_fetch_add_explicit(&mq->nelts, 1, memory_order_relaxed);
+        }
+        _multiqueue_unlock(q);
+        return rc;
+    }
+}
+
+xylem_multiqueue_node_t* xylem_multiqueue_pop(
+    xylem_multiqueue_t* mq, uint64_t* key) {
+    size_t tries = 0;
+
+    /* nelts only changes under a heap lock, so it never undercounts an
+     * element that is already visible in some heap.
+     */
+    while (atomic_load_explicit(&mq->nelts, memory_order_relaxed) > 0) {
+        size_t i = _multiqueue_rand(mq->nheaps);
+        size_t j = _multiqueue_rand(mq->nheaps - 1);
+        if (j >= i) {
+            j += 1;
+        }
+        multiqueue_heap_t* a = &mq->slots[i].q;
+        multiqueue_heap_t* b = &mq->slots[j].q;
+        uint64_t ta = atomic_load_explicit(&a->top, memory_order_relaxed);
+        uint64_t tb = atomic_load_explicit(&b->top, memory_order_relaxed);
+        multiqueue_heap_t* q = tb < ta ? b : a;
+
+        if (!_multiqueue_trylock(q)) {
+            _multiqueue_backoff(mq, &tries);
+            continue;
+        }
+        xylem_dheap_node_t* root = xylem_dheap_root(&q->heap);
+        if (!root) {
+            _multiqueue_unlock(q);
+            _multiqueue_backoff(mq, &tries);
+            continue;
+        }
+        if (key) {
+            *key = q->heap.slots[0].key;
+        }
+        xylem_dheap_dequeue(&q->heap);
+        atomic_fetch_sub_explicit(&mq->nelts, 1, memory_order_relaxed);
+        _multiqueue_unlock(q);
+        return xylem_multiqueue_entry(root, xylem_multiqueue_node_t, heap);
+    }
+    return NULL;
+}
+
+size_t xylem_multiqueue_len(xylem_multiqueue_t* mq) {
+    return atomic_load_explicit(&mq->nelts, memory_order_relaxed);
+}
\ No newline at end of file
@@ -20,28 +20,57 @@
  */
 
 #include "xylem.h"
+#include "platform/platform.h"
 
 #define RB_RED 0
 #define RB_BLACK 1
 
+#define RB_BATCH_LANES 8
+
+#define RB_PARENT(n) xylem_rbtree_parent(n)
+#define RB_COLOR(n)  xylem_rbtree_color(n)
+
+static inline void
+_rbtree_set_parent(xylem_rbtree_node_t* node, xylem_rbtree_node_t* parent) {
+#if defined(XYLEM_RBTREE_COMPACT)
+    node->parent_color = (uintptr_t)parent | (node->parent_color & 1);
+#else
+    node->parent = parent;
+#endif
+}
+
+static inline void _rbtree_set_color(xylem_rbtree_node_t* node, int color) {
+#if defined(XYLEM_RBTREE_COMPACT)
+    node->parent_color =
+        (node->parent_color & ~(uintptr_t)1) | (uintptr_t)color;
+#else
+    node->color = (char)color;
+#endif
+}
+
 static inline void
 _rbtree_rotate_left(xylem_rbtree_node_t* node, xylem_rbtree_t* tree) {
     xylem_rbtree_node_t* right = node->right;
 
     if ((node->right = right->left)) {
-        right->left->parent = node;
+        _rbtree_set_parent(right->left, node);
     }
     right->left = node;
-    if ((right->parent = node->parent)) {
-        if (node == node->parent->left) {
-            node->parent->left = right;
+    _rbtree_set_parent(right, RB_PARENT(node));
+    if (RB_PARENT(right)) {
+        if (node == RB_PARENT(node)->left) {
+            RB_PARENT(node)->left = right;
         } else {
-            node->parent->right = right;
+            RB_PARENT(node)->right = right;
         }
     } else {
         tree->root = right;
     }
-    node->parent = right;
+    _rbtree_set_parent(node, right);
+    if (tree->augment) {
+        tree->augment(node);
+        tree->augment(right);
+    }
 }
 
 static inline void
@@ -49,44 +78,60 @@ _rbtree_rotate_right(xylem_rbtree_node_t* node, xylem_rbtree_t* tree) {
     xylem_rbtree_node_t* left = node->left;
 
     if ((node->left = left->right)) {
-        left->right->parent = node;
+        _rbtree_set_parent(left->right, node);
     }
     left->right = node;
-    if ((left->parent = node->parent)) {
-        if (node == node->parent->right) {
-            node->parent->right = left;
+    _rbtree_set_parent(left, RB_PARENT(node));
+    if (RB_PARENT(left)) {
+        if (node == RB_PARENT(node)->right) {
+            RB_PARENT(node)->right = left;
         } else {
-            node->parent->left = left;
+            RB_PARENT(node)->left = left;
         }
     } else {
         tree->root = left;
     }
-    node->parent = left;
+    _rbtree_set_parent(node, left);
+    if (tree->augment) {
+        tree->augment(node);
+        tree->augment(left);
+    }
+}
+
+/* recompute the aggregates from `node` up to the root. */
+static inline void
+_rbtree_augment_path(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
+    for (; node; node = RB_PARENT(node)) {
+        tree->augment(node);
+    }
 }
 
 static inline void _rbtree_link_node(
     xylem_rbtree_node_t*  node,
     xylem_rbtree_node_t*  parent,
     xylem_rbtree_node_t** rb_link) {
-    node->parent = parent;
-    node->color = RB_RED;
+    _rbtree_set_parent(node, parent);
+    _rbtree_set_color(node, RB_RED);
     node->left = node->right = NULL;
     *rb_link = node;
 }
 
-static void
+/* returns true if the fixup ended by blackening a red root, i.e. the
+ * black height of the tree grew by one.
+ */
+static bool
 _rbtree_insert_color(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
     xylem_rbtree_node_t *parent, *gparent;
 
-    while ((parent = node->parent) && parent->color == RB_RED) {
-        gparent = parent->parent;
+    while ((parent = RB_PARENT(node)) && RB_COLOR(parent) == RB_RED) {
+        gparent = RB_PARENT(parent);
         if (parent == gparent->left) {
             {
                 register xylem_rbtree_node_t* uncle = gparent->right;
-                if (uncle && uncle->color == RB_RED) {
-                    uncle->color = RB_BLACK;
-                    parent->color = RB_BLACK;
-                    gparent->color = RB_RED;
+                if (uncle && RB_COLOR(uncle) == RB_RED) {
+                    _rbtree_set_color(uncle, RB_BLACK);
+                    _rbtree_set_color(parent, RB_BLACK);
+                    _rbtree_set_color(gparent, RB_RED);
                     node = gparent;
                     continue;
                 }
@@ -98,16 +143,16 @@ _rbtree_insert_color(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
                 parent = node;
                 node = tmp;
             }
-            parent->color = RB_BLACK;
-            gparent->color = RB_RED;
+            _rbtree_set_color(parent, RB_BLACK);
+            _rbtree_set_color(gparent, RB_RED);
             _rbtree_rotate_right(gparent, tree);
         } else {
             {
                 register xylem_rbtree_node_t* uncle = gparent->left;
-                if (uncle && uncle->color == RB_RED) {
-                    uncle->color = RB_BLACK;
-                    parent->color = RB_BLACK;
-                    gparent->color = RB_RED;
+                if (uncle && RB_COLOR(uncle) == RB_RED) {
+                    _rbtree_set_color(uncle, RB_BLACK);
+                    _rbtree_set_color(parent, RB_BLACK);
+                    _rbtree_set_color(gparent, RB_RED);
                     node = gparent;
                     continue;
                 }
@@ -119,12 +164,14 @@ _rbtree_insert_color(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
                 parent = node;
                 node = tmp;
             }
-            parent->color = RB_BLACK;
-            gparent->color = RB_RED;
+            _rbtree_set_color(parent, RB_BLACK);
+            _rbtree_set_color(gparent, RB_RED);
             _rbtree_rotate_left(gparent, tree);
         }
     }
-    tree->root->color = RB_BLACK;
+    bool grew = RB_COLOR(tree->root) == RB_RED;
+    _rbtree_set_color(tree->root, RB_BLACK);
+    return grew;
 }
 
 static void _rbtree_erase_color(
@@ -132,36 +179,36 @@ static void _rbtree_erase_color(
     xylem_rbtree_node_t* parent,
     xylem_rbtree_t*      tree) {
     xylem_rbtree_node_t* other;
-    while ((!node || node->color == RB_BLACK) && node != tree->root) {
+    while ((!node || RB_COLOR(node) == RB_BLACK) && node != tree->root) {
         if (parent->left == node) {
             other = parent->right;
             if (!other) {
                 return;
             }
-            if (other->color == RB_RED) {
-                other->color = RB_BLACK;
-                parent->color = RB_RED;
+            if (RB_COLOR(other) == RB_RED) {
+                _rbtree_set_color(other, RB_BLACK);
+                _rbtree_set_color(parent, RB_RED);
                 _rbtree_rotate_left(parent, tree);
                 other = parent->right;
             }
-            if ((!other->left || other->left->color == RB_BLACK) &&
-                (!other->right || other->right->color == RB_BLACK)) {
-                other->color = RB_RED;
+            if ((!other->left || RB_COLOR(other->left) == RB_BLACK) &&
+                (!other->right || RB_COLOR(other->right) == RB_BLACK)) {
+                _rbtree_set_color(other, RB_RED);
                 node = parent;
-                parent = node->parent;
+                parent = RB_PARENT(node);
             } else {
-                if (!other->right || other->right->color == RB_BLACK) {
+                if (!other->right || RB_COLOR(other->right) == RB_BLACK) {
                     if (other->left) {
-                        other->left->color = RB_BLACK;
+                        _rbtree_set_color(other->left, RB_BLACK);
                     }
-                    other->color = RB_RED;
+                    _rbtree_set_color(other, RB_RED);
                     _rbtree_rotate_right(other, tree);
                     other = parent->right;
                 }
-                other->color = parent->color;
-                parent->color = RB_BLACK;
+                _rbtree_set_color(other, RB_COLOR(parent));
+                _rbtree_set_color(parent, RB_BLACK);
                 if (other->right) {
-                    other->right->color = RB_BLACK;
+                    _rbtree_set_color(other->right, RB_BLACK);
                 }
                 _rbtree_rotate_left(parent, tree);
                 node = tree->root;
@@ -170,30 +217,30 @@ static void _rbtree_erase_color(
         } else {
             other = parent->left;
             if (other) {
-                if (other->color == RB_RED) {
-                    other->color = RB_BLACK;
-                    parent->color = RB_RED;
+                if (RB_COLOR(other) == RB_RED) {
+                    _rbtree_set_color(other, RB_BLACK);
+                    _rbtree_set_color(parent, RB_RED);
                     _rbtree_rotate_right(parent, tree);
                     other = parent->left;
                 }
-                if ((!other->left || other->left->color == RB_BLACK) &&
-                    (!other->right || other->right->color == RB_BLACK)) {
-                    other->color = RB_RED;
+                if ((!other->left || RB_COLOR(other->left) == RB_BLACK) &&
+                    (!other->right || RB_COLOR(other->right) == RB_BLACK)) {
+                    _rbtree_set_color(other, RB_RED);
                     node = parent;
-                    parent = node->parent;
+                    parent = RB_PARENT(node);
                 } else {
-                    if (!other->left || other->left->color == RB_BLACK) {
+                    if (!other->left || RB_COLOR(other->left) == RB_BLACK) {
                         if (other->right) {
-                            other->right->color = RB_BLACK;
+                            _rbtree_set_color(other->right, RB_BLACK);
                         }
-                        other->color = RB_RED;
+                        _rbtree_set_color(other, RB_RED);
                         _rbtree_rotate_left(other, tree);
                         other = parent->left;
                     }
-                    other->color = parent->color;
-                    parent->color = RB_BLACK;
+                    _rbtree_set_color(other, RB_COLOR(parent));
+                    _rbtree_set_color(parent, RB_BLACK);
                     if (other->left) {
-                        other->left->color = RB_BLACK;
+                        _rbtree_set_color(other->left, RB_BLACK);
                     }
                     _rbtree_rotate_right(parent, tree);
                     node = tree->root;
@@ -203,7 +250,7 @@ static void _rbtree_erase_color(
         }
     }
     if (node) {
-        node->color = RB_BLACK;
+        _rbtree_set_color(node, RB_BLACK);
     }
 }
 
@@ -212,12 +259,47 @@ void xylem_rbtree_init(
     xylem_rbtree_cmp_nn_fn_t cmp_nn,
     xylem_rbtree_cmp_kn_fn_t cmp_kn) {
     tree->root = NULL;
+    tree->leftmost = NULL;
+    tree->rightmost = NULL;
     tree->cmp_nn = cmp_nn;
     tree->cmp_kn = cmp_kn;
+    tree->augment = NULL;
+}
+
+void xylem_rbtree_init_augmented(
+    xylem_rbtree_t*           tree,
+    xylem_rbtree_cmp_nn_fn_t  cmp_nn,
+    xylem_rbtree_cmp_kn_fn_t  cmp_kn,
+    xylem_rbtree_augment_fn_t augment) {
+    xylem_rbtree_init(tree, cmp_nn, cmp_kn);
+    tree->augment = augment;
+}
+
+void xylem_rbtree_link(
+    xylem_rbtree_t*       tree,
+    xylem_rbtree_node_t*  node,
+    xylem_rbtree_node_t*  parent,
+    xylem_rbtree_node_t** link) {
+    _rbtree_link_node(node, parent, link);
+    if (!parent || (parent == tree->leftmost && link == &parent->left)) {
+        tree->leftmost = node;
+    }
+    if (!parent || (parent == tree->rightmost && link == &parent->right)) {
+        tree->rightmost = node;
+    }
+    if (tree->augment) {
+        _rbtree_augment_path(tree, node);
+    }
+    _rbtree_insert_color(tree, node);
 }
 
 void
 xylem_rbtree_insert(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
+    xylem_rbtree_insert_unique(tree, node);
+}
+
+xylem_rbtree_node_t*
+xylem_rbtree_insert_unique(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
     xylem_rbtree_node_t** p = &(tree->root);
     xylem_rbtree_node_t*  parent = NULL;
     while (*p) {
@@ -230,11 +312,319 @@ xylem_rbtree_insert(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
         } else if (r > 0) {
             p = &(*p)->right;
         } else {
-            return;
+            return parent;
         }
     }
-    _rbtree_link_node(node, parent, p);
-    _rbtree_insert_color(tree, node);
+    xylem_rbtree_link(tree, node, parent, p);
+    return NULL;
+}
+
+xylem_rbtree_node_t* xylem_rbtree_insert_hint(
+    xylem_rbtree_t*      tree,
+    xylem_rbtree_node_t* node,
+    xylem_rbtree_node_t* hint) {
+    xylem_rbtree_node_t* succ;
+    int                  r;
+
+    if (!tree->root) {
+        xylem_rbtree_link(tree, node, NULL, &tree->root);
+        return NULL;
+    }
+    if (!hint) {
+        /* expected to become the new first node. */
+        succ = tree->leftmost;
+        r = tree->cmp_nn(node, succ);
+        if (r < 0) {
+            xylem_rbtree_link(tree, node, succ, &succ->left);
+            return NULL;
+        }
+        return r == 0 ? succ : xylem_rbtree_insert_unique(tree, node);
+    }
+    r = tree->cmp_nn(node, hint);
+    if (r == 0) {
+        return hint;
+    }
+    if (r < 0) {
+        return xylem_rbtree_insert_unique(tree, node);
+    }
+    /* node sorts after the hint; it fits if it also sorts before the
+     * hint's successor. the free slot is then hint->right or succ->left.
+     */
+    succ = hint == tree->rightmost ? NULL : xylem_rbtree_next(hint);
+    if (succ) {
+        r = tree->cmp_nn(node, succ);
+        if (r == 0) {
+            return succ;
+        }
+        if (r > 0) {
+            return xylem_rbtree_insert_unique(tree, node);
+        }
+    }
+    if (!hint->right) {
+        xylem_rbtree_link(tree, node, hint, &hint->right);
+    } else {
+        xylem_rbtree_link(tree, node, succ, &succ->left);
+    }
+    return NULL;
+}
+
+/* link nodes[0..n) as a balanced subtree at depth `depth`. with a middle
+ * split every empty link sits at depth h or h + 1, so painting the nodes
+ * below depth h red gives each path the same h black nodes.
+ */
+static xylem_rbtree_node_t* _rbtree_build(
+    xylem_rbtree_t*       tree,
+    xylem_rbtree_node_t** nodes,
+    size_t                n,
+    xylem_rbtree_node_t*  parent,
+    unsigned              depth,
+    unsigned              h) {
+    if (n == 0) {
+        return NULL;
+    }
+    size_t               mid = n / 2;
+    xylem_rbtree_node_t* node = nodes[mid];
+
+    /* in-order, so the nodes are written in array order. */
+    node->left = _rbtree_build(tree, nodes, mid, node, depth + 1, h);
+    _rbtree_set_parent(node, parent);
+    _rbtree_set_color(node, depth >= h ? RB_RED : RB_BLACK);
+    node->right =
+        _rbtree_build(tree, nodes + mid + 1, n - mid - 1, node, depth + 1, h);
+    if (tree->augment) {
+        tree->augment(node);
+    }
+    return node;
+}
+
+void xylem_rbtree_build_sorted(
+    xylem_rbtree_t* tree, xylem_rbtree_node_t** nodes, size_t n) {
+    unsigned h = 0;
+
+    /* h = floor(log2(n + 1)), the number of completely filled levels. */
+    while (((size_t)2 << h) - 1 <= n) {
+        h++;
+    }
+    tree->root = _rbtree_build(tree, nodes, n, NULL, 0, h);
+    tree->leftmost = n ? nodes[0] : NULL;
+    tree->rightmost = n ? nodes[n - 1] : NULL;
+}
+
+/* black nodes on the left spine, i.e. the black height of `node`. */
+static unsigned _rbtree_black_height(const xylem_rbtree_node_t* node) {
+    unsigned h = 0;
+
+    for (; node; node = node->left) {
+        h += RB_COLOR(node) == RB_BLACK;
+    }
+    return h;
+}
+
+/* join subtrees `l` and `r`, with black roots and black heights `hl` and
+ * `hr`, around `k`, where l < k < r. `scratch` supplies the augment
+ * callback and receives the root; the new black height goes to `*h`.
+ */
+static void _rbtree_join3(
+    xylem_rbtree_t*      scratch,
+    xylem_rbtree_node_t* l,
+    unsigned             hl,
+    xylem_rbtree_node_t* k,
+    xylem_rbtree_node_t* r,
+    unsigned             hr,
+    unsigned*            h) {
+    xylem_rbtree_node_t *c, *p = NULL;
+    unsigned             hc;
+
+    if (hl == hr) {
+        _rbtree_set_parent(k, NULL);
+        _rbtree_set_color(k, RB_BLACK);
+        if ((k->left = l)) {
+            _rbtree_set_parent(l, k);
+        }
+        if ((k->right = r)) {
+            _rbtree_set_parent(r, k);
+        }
+        if (scratch->augment) {
+            scratch->augment(k);
+        }
+        scratch->root = k;
+        *h = hl + 1;
+        return;
+    }
+    /* hang `k` off the spine of the taller tree, at the first black node
+     * as tall as the shorter tree, then fix the red edge as an insert.
+     */
+    if (hl > hr) {
+        _rbtree_set_parent(l, NULL);
+        scratch->root = l;
+        c = l;
+        hc = hl;
+        while (hc > hr || (c && RB_COLOR(c) == RB_RED)) {
+            hc -= RB_COLOR(c) == RB_BLACK;
+            p = c;
+            c = c->right;
+        }
+        p->right = k;
+        k->left = c;
+        k->right = r;
+    } else {
+        _rbtree_set_parent(r, NULL);
+        scratch->root = r;
+        c = r;
+        hc = hr;
+        while (hc > hl || (c && RB_COLOR(c) == RB_RED)) {
+            hc -= RB_COLOR(c) == RB_BLACK;
+            p = c;
+            c = c->left;
+        }
+        p->left = k;
+        k->left = l;
+        k->right = c;
+    }
+    _rbtree_set_parent(k, p);
+    _rbtree_set_color(k, RB_RED);
+    if (k->left) {
+        _rbtree_set_parent(k->left, k);
+    }
+    if (k->right) {
+        _rbtree_set_parent(k->right, k);
+    }
+    if (scratch->augment) {
+        _rbtree_augment_path(scratch, k);
+    }
+    *h = (hl > hr ? hl : hr) + _rbtree_insert_color(scratch, k);
+}
+
+/* split the subtree at `node` (black height `h`) into the nodes below
+ * `key` and the rest. each level costs a join whose price is the black
+ * height difference, which telescopes to O(log n) overall.
+ */
+static void _rbtree_split(
+    xylem_rbtree_t*       scratch,
+    xylem_rbtree_node_t*  node,
+    unsigned              h,
+    const void*           key,
+    xylem_rbtree_node_t** l,
+    unsigned*             hl,
+    xylem_rbtree_node_t** r,
+    unsigned*             hr) {
+    if (!node) {
+        *l = *r = NULL;
+        *hl = *hr = 0;
+        return;
+    }
+    if (RB_COLOR(node) == RB_RED) {
+        _rbtree_set_color(node, RB_BLACK);
+        h++;
+    }
+    xylem_rbtree_node_t* lc = node->left;
+    xylem_rbtree_node_t* rc = node->right;
+    unsigned             hlc = h - 1;
+    unsigned             hrc = h - 1;
+
+    if (lc && RB_COLOR(lc) == RB_RED) {
+        _rbtree_set_color(lc, RB_BLACK);
+        hlc++;
+    }
+    if (rc && RB_COLOR(rc) == RB_RED) {
+        _rbtree_set_color(rc, RB_BLACK);
+        hrc++;
+    }
+    if (scratch->cmp_kn(key, (const xylem_rbtree_node_t*)node) <= 0) {
+        xylem_rbtree_node_t* m;
+        unsigned             hm;
+
+        _rbtree_split(scratch, lc, hlc, key, l, hl, &m, &hm);
+        _rbtree_join3(scratch, m, hm, node, rc, hrc, hr);
+        *r = scratch->root;
+    } else {
+        xylem_rbtree_node_t* m;
+        unsigned             hm;
+
+        _rbtree_split(scratch, rc, hrc, key, &m, &hm, r, hr);
+        _rbtree_join3(scratch, lc, hlc, node, m, hm, hl);
+        *l = scratch->root;
+    }
+}
+
+/* make `tree` hold the subtree at `root`, restoring the cached ends. */
+static void _rbtree_adopt(xylem_rbtree_t* tree, xylem_rbtree_node_t* root) {
+    tree->root = tree->leftmost = tree->rightmost = root;
+    if (!root) {
+        return;
+    }
+    _rbtree_set_parent(root, NULL);
+    while (tree->leftmost->left) {
+        tree->leftmost = tree->leftmost->left;
+    }
+    while (tree->rightmost->right) {
+        tree->rightmost = tree->rightmost->right;
+    }
+}
+
+void xylem_rbtree_split(
+    xylem_rbtree_t* tree,
+    const void*     key,
+    xylem_rbtree_t* left,
+    xylem_rbtree_t* right) {
+    xylem_rbtree_t       scratch = *tree;
+    xylem_rbtree_node_t *l, *r;
+    unsigned             hl, hr;
+
+    _rbtree_split(
+        &scratch, tree->root, _rbtree_black_height(tree->root), key, &l, &hl,
+        &r, &hr);
+    *left = scratch;
+    *right = scratch;
+    _rbtree_adopt(left, l);
+    _rbtree_adopt(right, r);
+    if (tree != left && tree != right) {
+        _rbtree_adopt(tree, NULL);
+    }
+}
+
+void xylem_rbtree_join(xylem_rbtree_t* left, xylem_rbtree_t* right) {
+    xylem_rbtree_node_t* k = right->leftmost;
+    xylem_rbtree_node_t* rightmost = right->rightmost;
+    unsigned             h;
+
+    if (!k) {
+        return;
+    }
+    if (!left->root) {
+        left->root = right->root;
+        left->leftmost = right->leftmost;
+        left->rightmost = right->rightmost;
+    } else {
+        xylem_rbtree_t scratch = *left;
+
+        xylem_rbtree_erase(right, k);
+        _rbtree_join3(
+            &scratch, left->root, _rbtree_black_height(left->root), k,
+            right->root, _rbtree_black_height(right->root), &h);
+        left->root = scratch.root;
+        left->rightmost = rightmost;
+    }
+    _rbtree_adopt(right, NULL);
+}
+
+void xylem_rbtree_extract(
+    xylem_rbtree_t* tree,
+    const void*     lo,
+    const void*     hi,
+    xylem_rbtree_t* out) {
+    xylem_rbtree_t rest;
+
+    *out = *tree;
+    if (lo) {
+        xylem_rbtree_split(tree, lo, tree, out);
+    } else {
+        _rbtree_adopt(tree, NULL);
+    }
+    if (hi) {
+        xylem_rbtree_split(out, hi, out, &rest);
+        xylem_rbtree_join(tree, &rest);
+    }
 }
 
 void xylem_rbtree_erase(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
@@ -244,6 +634,12 @@ void xylem_rbtree_erase(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
     xylem_rbtree_node_t *child, *parent;
     int                  color;
 
+    if (node == tree->leftmost) {
+        tree->leftmost = xylem_rbtree_next(node);
+    }
+    if (node == tree->rightmost) {
+        tree->rightmost = xylem_rbtree_prev(node);
+    }
     if (!node->left) {
         child = node->right;
     } else if (!node->right) {
@@ -254,39 +650,39 @@ void xylem_rbtree_erase(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
         while ((left = node->left)) {
             node = left;
         }
-        if (old->parent) {
-            if (old->parent->left == old) {
-                old->parent->left = node;
+        if (RB_PARENT(old)) {
+            if (RB_PARENT(old)->left == old) {
+                RB_PARENT(old)->left = node;
             } else {
-                old->parent->right = node;
+                RB_PARENT(old)->right = node;
             }
         } else {
             tree->root = node;
         }
         child = node->right;
-        parent = node->parent;
-        color = node->color;
+        parent = RB_PARENT(node);
+        color = RB_COLOR(node);
         if (parent == old) {
             parent = node;
         } else {
             if (child) {
-                child->parent = parent;
+                _rbtree_set_parent(child, parent);
             }
             parent->left = child;
             node->right = old->right;
-            old->right->parent = node;
+            _rbtree_set_parent(old->right, node);
         }
-        node->parent = old->parent;
-        node->color = old->color;
+        _rbtree_set_parent(node, RB_PARENT(old));
+        _rbtree_set_color(node, RB_COLOR(old));
         node->left = old->left;
-        old->left->parent = node;
+        _rbtree_set_parent(old->left, node);
 
         goto color;
     }
-    parent = node->parent;
-    color = node->color;
+    parent = RB_PARENT(node);
+    color = RB_COLOR(node);
     if (child) {
-        child->parent = parent;
+        _rbtree_set_parent(child, parent);
     }
     if (parent) {
         if (parent->left == node) {
@@ -298,6 +694,10 @@ void xylem_rbtree_erase(xylem_rbtree_t* tree, xylem_rbtree_node_t* node) {
         tree->root = child;
     }
 color:
+    /* `parent` is the lowest node whose subtree lost a node. */
+    if (tree->augment) {
+        _rbtree_augment_path(tree, parent);
+    }
     if (color == RB_BLACK) {
         _rbtree_erase_color(child, parent, tree);
     }
@@ -328,6 +728,56 @@ xylem_rbtree_node_t* xylem_rbtree_find(xylem_rbtree_t* tree, const void* key) {
     return NULL;
 }
 
+size_t xylem_rbtree_find_batch(
+    xylem_rbtree_t*       tree,
+    const void* const*    keys,
+    size_t                n,
+    xylem_rbtree_node_t** out) {
+    xylem_rbtree_node_t* cur[RB_BATCH_LANES];
+    size_t               idx[RB_BATCH_LANES];
+    size_t               active = 0;
+    size_t               next = 0;
+    size_t               found = 0;
+
+    for (; active < RB_BATCH_LANES && next < n; active++, next++) {
+        idx[active] = next;
+        cur[active] = tree->root;
+    }
+    /* step every lane one level per pass, prefetching the child it will
+     * compare against next pass, so the misses of all lanes overlap. a
+     * lane that finishes takes the next key, or is dropped.
+     */
+    while (active) {
+        for (size_t i = 0; i < active;) {
+            xylem_rbtree_node_t* c = cur[i];
+            int                  r = 1;
+
+            if (c) {
+                r = tree->cmp_kn(keys[idx[i]], (const xylem_rbtree_node_t*)c);
+                if (r != 0) {
+                    c = r < 0 ? c->left : c->right;
+                    if (c) {
+                        platform_prefetch(c);
+                        cur[i++] = c;
+                        continue;
+                    }
+                }
+            }
+            out[idx[i]] = r == 0 ? cur[i] : NULL;
+            found += r == 0;
+            if (next < n) {
+                idx[i] = next++;
+                cur[i++] = tree->root;
+            } else {
+                active--;
+                idx[i] = idx[active];
+                cur[i] = cur[active];
+            }
+        }
+    }
+    return found;
+}
+
 xylem_rbtree_node_t* xylem_rbtree_next(xylem_rbtree_node_t* node) {
     if (!node) {
         return NULL;
@@ -347,7 +797,7 @@ xylem_rbtree_node_t* xylem_rbtree_next(xylem_rbtree_node_t* node) {
        ancestor is a right-hand child of its parent, keep going
        up. First time it's a left-hand child of its parent, said
        parent is our 'next' node. */
-    while ((parent = node->parent) && node == parent->right) {
+    while ((parent = RB_PARENT(node)) && node == parent->right) {
         node = parent;
     }
     return parent;
@@ -368,7 +818,7 @@ xylem_rbtree_node_t* xylem_rbtree_prev(xylem_rbtree_node_t* node) {
     }
     /* No left-hand children. Go up till we find an ancestor which
        is a right-hand child of its parent */
-    while ((parent = node->parent) && node == parent->left) {
+    while ((parent = RB_PARENT(node)) && node == parent->left) {
         node = parent;
     }
     return parent;
@@ -378,28 +828,118 @@ xylem_rbtree_node_t* xylem_rbtree_first(xylem_rbtree_t* tree) {
     if (!tree) {
         return NULL;
     }
-    xylem_rbtree_node_t* n;
-    n = tree->root;
-    if (!n) {
+    return tree->leftmost;
+}
+
+xylem_rbtree_node_t* xylem_rbtree_last(xylem_rbtree_t* tree) {
+    if (!tree) {
+        return NULL;
+    }
+    return tree->rightmost;
+}
+
+xylem_rbtree_node_t*
+xylem_rbtree_lower_bound(xylem_rbtree_t* tree, const void* key) {
+    if (!tree || !key) {
+        return NULL;
+    }
+    xylem_rbtree_node_t* n = tree->root;
+    xylem_rbtree_node_t* bound = NULL;
+    while (n) {
+        if (tree->cmp_kn(key, (const xylem_rbtree_node_t*)n) <= 0) {
+            bound = n;
+            n = n->left;
+        } else {
+            n = n->right;
+        }
+    }
+    return bound;
+}
+
+xylem_rbtree_node_t*
+xylem_rbtree_upper_bound(xylem_rbtree_t* tree, const void* key) {
+    if (!tree || !key) {
         return NULL;
     }
-    while (n->left) {
-        n = n->left;
+    xylem_rbtree_node_t* n = tree->root;
+    xylem_rbtree_node_t* bound = NULL;
+    while (n) {
+        if (tree->cmp_kn(key, (const xylem_rbtree_node_t*)n) < 0) {
+            bound = n;
+            n = n->left;
+        } else {
+            n = n->right;
+        }
     }
-    return n;
+    return bound;
 }
 
-xylem_rbtree_node_t* xylem_rbtree_last(xylem_rbtree_t* tree) {
-    if (!tree) {
+/* drop `node` if it is past the upper bound. */
+static xylem_rbtree_node_t*
+_rbtree_range_clip(xylem_rbtree_range_t* range, xylem_rbtree_node_t* node) {
+    if (node && range->hi &&
+        range->tree->cmp_kn(range->hi, (const xylem_rbtree_node_t*)node) <= 0) {
         return NULL;
     }
-    xylem_rbtree_node_t* n;
-    n = tree->root;
-    if (!n) {
+    return node;
+}
+
+void xylem_rbtree_range_init(
+    xylem_rbtree_range_t* range,
+    xylem_rbtree_t*       tree,
+    const void*           lo,
+    const void*           hi) {
+    range->tree = tree;
+    range->hi = hi;
+    range->next = _rbtree_range_clip(
+        range, lo ? xylem_rbtree_lower_bound(tree, lo) : tree->leftmost);
+}
+
+xylem_rbtree_node_t* xylem_rbtree_range_next(xylem_rbtree_range_t* range) {
+    xylem_rbtree_node_t* node = range->next;
+
+    if (node) {
+        range->next = _rbtree_range_clip(range, xylem_rbtree_next(node));
+    }
+    return node;
+}
+
+static inline size_t _rbtree_size(const xylem_rbtree_node_t* node) {
+    return node ? xylem_rbtree_entry(node, xylem_rbtree_snode_t, node)->size
+                : 0;
+}
+
+void xylem_rbtree_size_augment(xylem_rbtree_node_t* node) {
+    xylem_rbtree_entry(node, xylem_rbtree_snode_t, node)->size =
+        1 + _rbtree_size(node->left) + _rbtree_size(node->right);
+}
+
+xylem_rbtree_node_t* xylem_rbtree_select(xylem_rbtree_t* tree, size_t k) {
+    if (!tree) {
         return NULL;
     }
-    while (n->right) {
-        n = n->right;
+    xylem_rbtree_node_t* n = tree->root;
+    while (n) {
+        size_t left = _rbtree_size(n->left);
+        if (k < left) {
+            n = n->left;
+        } else if (k > left) {
+            k -= left + 1;
+            n = n->right;
+        } else {
+            return n;
+        }
+    }
+    return NULL;
+}
+
+size_t xylem_rbtree_rank(xylem_rbtree_node_t* node) {
+    size_t rank = _rbtree_size(node->left);
+
+    for (; RB_PARENT(node); node = RB_PARENT(node)) {
+        if (node == RB_PARENT(node)->right) {
+            rank += _rbtree_size(RB_PARENT(node)->left) + 1;
+        }
     }
-    return n;
+    return rank;
 }
\ No newline at end of file
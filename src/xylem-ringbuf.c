@@ -20,15 +20,53 @@
  */
 
 #include "xylem.h"
+#include "platform/platform.h"
+
+typedef struct ringbuf_hdr_s ringbuf_hdr_t;
+
+/* state shared by producers and consumers. for process-shared rings it sits
+ * at the start of the mapping, followed by the entries, so it must only hold
+ * fixed-size, address-free fields.
+ */
+struct ringbuf_hdr_s {
+    _Atomic uint64_t magic;    /* stored last, once the header is ready */
+    uint32_t         esz;      /* entry size (bytes) */
+    uint32_t         mask;     /* mask = cap - 1 */
+    int32_t          flags;
+    uint32_t         padding;
+    _Atomic uint64_t whead;    /* reserved by producers (MPSC) */
+    _Atomic uint64_t wpos;     /* write pos  */
+    _Atomic uint64_t rpos;     /* read pos   */
+    _Atomic uint64_t dropped;  /* entries overwritten before being read */
+    _Atomic uint32_t rfutex;   /* bumped when entries are published */
+    _Atomic uint32_t wfutex;   /* bumped when space is released */
+    _Atomic uint32_t rwaiters; /* readers sleeping on rfutex */
+    _Atomic uint32_t wwaiters; /* writers sleeping on wfutex */
+};
 
 struct xylem_ringbuf_s {
-    char*    buf;
-    uint64_t wpos; /* write pos  */
-    uint64_t rpos; /* read pos   */
-    uint32_t mask; /* mask = cap - 1 */
-    uint32_t esz;  /* entry size (bytes) */
+    char*          buf;
+    ringbuf_hdr_t* hdr;
+    uint32_t       mask; /* copies of the header fields for the fast path */
+    uint32_t       esz;
+    int            flags;
+    bool           shared;
+    bool           owner; /* created the shared mapping, unlinks it */
+    platform_shm_t shm;
+    char*          name;
+    ringbuf_hdr_t  local;
 };
 
+#define RINGBUF_SPIN_COUNT 128
+#define RINGBUF_POLL_MS 1
+#define RINGBUF_MAGIC 0x58594c4d52494e47ull /* "XYLMRING" */
+#define RINGBUF_HDR_SIZE                                                       \
+    ((sizeof(ringbuf_hdr_t) + 63) & ~(size_t)63) /* entries cache aligned */
+
+#if ATOMIC_LLONG_LOCK_FREE != 2 || ATOMIC_INT_LOCK_FREE != 2
+#error "process-shared ring buffers need lock-free 32 and 64-bit atomics"
+#endif
+
 static inline uint32_t _ringbuffer_rounddown_pow_of_two(uint32_t n) {
     if (n == 0) {
         return 0;
@@ -95,36 +133,257 @@ static inline void _ringbuffer_internal_read(
     }
 }
 
-static inline uint32_t
-_ringbuffer_internal_read_peek(xylem_ringbuf_t* ring, void* buf, uint32_t len) {
-    uint64_t current_len = ring->wpos - ring->rpos;
-    if (current_len > UINT32_MAX) {
-        current_len = UINT32_MAX;
+/* the fence pairs with the waiter's increment of `waiters`: either the
+ * waiter sees the new positions, or we see the waiter and wake it up.
+ * rings without XYLEM_RINGBUF_BLOCKING skip both, their waiters poll.
+ */
+static inline void _ringbuffer_notify(
+    xylem_ringbuf_t* ring, _Atomic uint32_t* waiters, _Atomic uint32_t* futex) {
+    if (!(ring->flags & XYLEM_RINGBUF_BLOCKING)) {
+        return;
     }
-    uint32_t actual_len = (uint32_t)current_len;
-    if (len > actual_len) {
-        len = actual_len;
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiters, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(futex, 1, memory_order_release);
+        platform_futex_wake(futex, true, ring->shared);
     }
-    _ringbuffer_internal_read(ring, buf, len, ring->rpos);
-    return len;
 }
 
-xylem_ringbuf_t* xylem_ringbuf_create(size_t esize, size_t bufsize) {
+static inline bool _ringbuffer_readable(xylem_ringbuf_t* ring) {
+    return xylem_ringbuf_len(ring) > 0;
+}
+
+static inline bool _ringbuffer_writable(xylem_ringbuf_t* ring) {
+    return xylem_ringbuf_avail(ring) > 0;
+}
+
+/* spin for a while, then sleep on `futex` until `ready` holds or the
+ * deadline passes. returns false on timeout.
+ */
+static bool _ringbuffer_wait(
+    xylem_ringbuf_t*  ring,
+    _Atomic uint32_t* waiters,
+    _Atomic uint32_t* futex,
+    bool (*ready)(xylem_ringbuf_t*),
+    uint64_t deadline) {
+
+    for (int i = 0; i < RINGBUF_SPIN_COUNT; i++) {
+        if (ready(ring)) {
+            return true;
+        }
+        platform_cpu_relax();
+    }
+    for (;;) {
+        int timeout_ms = -1;
+
+        atomic_fetch_add_explicit(waiters, 1, memory_order_seq_cst);
+        uint32_t seq = atomic_load_explicit(futex, memory_order_acquire);
+        if (ready(ring)) {
+            atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+            return true;
+        }
+        if (deadline != UINT64_MAX) {
+            uint64_t now = platform_clock_ms();
+            if (now >= deadline) {
+                atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+                return false;
+            }
+            uint64_t left = deadline - now;
+            timeout_ms = (left > INT_MAX) ? INT_MAX : (int)left;
+        }
+        if (!(ring->flags & XYLEM_RINGBUF_BLOCKING) &&
+            (timeout_ms < 0 || timeout_ms > RINGBUF_POLL_MS)) {
+            timeout_ms = RINGBUF_POLL_MS; /* nobody will wake us */
+        }
+        platform_futex_wait(futex, seq, timeout_ms, ring->shared);
+        atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+    }
+}
+
+static inline uint64_t _ringbuffer_deadline(int timeout_ms) {
+    if (timeout_ms < 0) {
+        return UINT64_MAX;
+    }
+    return platform_clock_ms() + (uint64_t)timeout_ms;
+}
+
+static inline uint32_t _ringbuffer_clamp_len(uint64_t len, size_t count) {
+    if (len > UINT32_MAX) {
+        len = UINT32_MAX;
+    }
+    return (count < len) ? (uint32_t)count : (uint32_t)len;
+}
+
+/* in overwrite mode the writer never waits for readers. before it reuses the
+ * slots of the oldest entries it pushes rpos past them, so a reader that
+ * copied those entries in the meantime notices the moved rpos and retries.
+ */
+static size_t _ringbuffer_overwrite_write(
+    xylem_ringbuf_t* ring, const void* buf, size_t entry_count) {
+
+    uint32_t cap = ring->mask + 1;
+    uint64_t skipped = 0;
+
+    if (entry_count > cap) {
+        skipped = entry_count - cap;
+        buf = (const char*)buf + (size_t)skipped * ring->esz;
+    }
+    uint32_t count32 = (uint32_t)(entry_count - skipped);
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_relaxed);
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+
+    if (w + count32 > cap) {
+        uint64_t need = w + count32 - cap;
+        while (r < need) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &ring->hdr->rpos,
+                    &r,
+                    need,
+                    memory_order_acq_rel,
+                    memory_order_acquire)) {
+                skipped += need - r;
+                break;
+            }
+        }
+    }
+    if (skipped) {
+        atomic_fetch_add_explicit(
+            &ring->hdr->dropped, skipped, memory_order_relaxed);
+    }
+    _ringbuffer_internal_write(ring, buf, count32, w);
+    atomic_store_explicit(&ring->hdr->wpos, w + count32, memory_order_release);
+    _ringbuffer_notify(ring, &ring->hdr->rwaiters, &ring->hdr->rfutex);
+
+    return entry_count;
+}
+
+/* producers reserve space by advancing whead, fill it in parallel, then
+ * publish it by advancing wpos in reservation order.
+ */
+static size_t _ringbuffer_mpsc_write(
+    xylem_ringbuf_t* ring, const void* buf, size_t entry_count) {
+
+    uint32_t cap = ring->mask + 1;
+    uint64_t h = atomic_load_explicit(&ring->hdr->whead, memory_order_relaxed);
+    uint32_t count32;
+
+    for (;;) {
+        uint64_t r =
+            atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+        if (h - r > cap) {
+            /* stale reservation head, the reader already moved past it. */
+            h = atomic_load_explicit(&ring->hdr->whead, memory_order_relaxed);
+            continue;
+        }
+        count32 = _ringbuffer_clamp_len(cap - (h - r), entry_count);
+        if (count32 == 0) {
+            return 0;
+        }
+        if (atomic_compare_exchange_weak_explicit(
+                &ring->hdr->whead,
+                &h,
+                h + count32,
+                memory_order_relaxed,
+                memory_order_relaxed)) {
+            break;
+        }
+    }
+    _ringbuffer_internal_write(ring, buf, count32, h);
+
+    for (int spins = 0;
+         atomic_load_explicit(&ring->hdr->wpos, memory_order_acquire) != h;
+         spins++) {
+        if (spins < RINGBUF_SPIN_COUNT) {
+            platform_cpu_relax();
+        } else {
+            thrd_yield();
+        }
+    }
+    atomic_store_explicit(&ring->hdr->wpos, h + count32, memory_order_release);
+    _ringbuffer_notify(ring, &ring->hdr->rwaiters, &ring->hdr->rfutex);
+
+    return (size_t)count32;
+}
+
+static size_t _ringbuffer_overwrite_read(
+    xylem_ringbuf_t* ring, void* buf, size_t entry_count) {
+
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+    for (;;) {
+        uint64_t w =
+            atomic_load_explicit(&ring->hdr->wpos, memory_order_acquire);
+        if (w - r > ring->mask + 1) {
+            /* lapped since rpos was loaded; the writer has moved it on. */
+            r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+            continue;
+        }
+        uint32_t count32 = _ringbuffer_clamp_len(w - r, entry_count);
+        if (count32 == 0) {
+            return 0;
+        }
+        _ringbuffer_internal_read(ring, buf, count32, r);
+        /* the copy is only valid if nobody moved rpos while it was taken. */
+        if (atomic_compare_exchange_weak_explicit(
+                &ring->hdr->rpos,
+                &r,
+                r + count32,
+                memory_order_acq_rel,
+                memory_order_acquire)) {
+            return count32;
+        }
+    }
+}
+
+/* validate the requested geometry and return the entry capacity, rounded
+ * down to a power of two; 0 if the request is unusable.
+ */
+static uint32_t
+_ringbuffer_geometry(size_t esize, size_t bufsize, int flags) {
     if (esize == 0 || bufsize < esize) {
-        return NULL;
+        return 0;
     }
     if (esize > UINT32_MAX) {
-        return NULL;
+        return 0;
+    }
+    if ((flags & XYLEM_RINGBUF_OVERWRITE) && (flags & XYLEM_RINGBUF_MPSC)) {
+        return 0;
     }
     size_t elem_count = bufsize / esize;
     if (elem_count == 0) {
-        return NULL;
+        return 0;
     }
     if (elem_count > UINT32_MAX) {
         elem_count = UINT32_MAX;
     }
-    uint32_t n = (uint32_t)elem_count;
-    uint32_t cap = _ringbuffer_rounddown_pow_of_two(n);
+    return _ringbuffer_rounddown_pow_of_two((uint32_t)elem_count);
+}
+
+static void _ringbuffer_hdr_init(
+    ringbuf_hdr_t* hdr, size_t esize, uint32_t cap, int flags) {
+    hdr->esz = (uint32_t)esize;
+    hdr->mask = cap - 1;
+    hdr->flags = flags;
+    hdr->padding = 0;
+    atomic_init(&hdr->whead, 0);
+    atomic_init(&hdr->wpos, 0);
+    atomic_init(&hdr->rpos, 0);
+    atomic_init(&hdr->dropped, 0);
+    atomic_init(&hdr->rfutex, 0);
+    atomic_init(&hdr->wfutex, 0);
+    atomic_init(&hdr->rwaiters, 0);
+    atomic_init(&hdr->wwaiters, 0);
+    atomic_store_explicit(&hdr->magic, RINGBUF_MAGIC, memory_order_release);
+}
+
+static void _ringbuffer_handle_init(xylem_ringbuf_t* ring) {
+    ring->esz = ring->hdr->esz;
+    ring->mask = ring->hdr->mask;
+    ring->flags = ring->hdr->flags;
+}
+
+xylem_ringbuf_t*
+xylem_ringbuf_create_ex(size_t esize, size_t bufsize, int flags) {
+    uint32_t cap = _ringbuffer_geometry(esize, bufsize, flags);
     if (cap == 0) {
         return NULL;
     }
@@ -139,10 +398,83 @@ xylem_ringbuf_t* xylem_ringbuf_create(size_t esize, size_t bufsize) {
         free(ring);
         return NULL;
     }
-    ring->esz = (uint32_t)esize;
-    ring->mask = cap - 1;
-    ring->wpos = 0;
-    ring->rpos = 0;
+    ring->hdr = &ring->local;
+    ring->shared = false;
+    ring->owner = false;
+    ring->name = NULL;
+    _ringbuffer_hdr_init(ring->hdr, esize, cap, flags);
+    _ringbuffer_handle_init(ring);
+
+    return ring;
+}
+
+xylem_ringbuf_t* xylem_ringbuf_create(size_t esize, size_t bufsize) {
+    return xylem_ringbuf_create_ex(esize, bufsize, 0);
+}
+
+xylem_ringbuf_t* xylem_ringbuf_create_shared(
+    const char* name, size_t esize, size_t bufsize, int flags) {
+    uint32_t cap = _ringbuffer_geometry(esize, bufsize, flags);
+    if (!name || cap == 0) {
+        return NULL;
+    }
+    xylem_ringbuf_t* ring = (xylem_ringbuf_t*)malloc(sizeof(xylem_ringbuf_t));
+    if (!ring) {
+        return NULL;
+    }
+    ring->name = malloc(strlen(name) + 1);
+    if (!ring->name) {
+        free(ring);
+        return NULL;
+    }
+    strcpy(ring->name, name);
+
+    size_t size = RINGBUF_HDR_SIZE + (size_t)cap * esize;
+    if (platform_shm_create(&ring->shm, name, size) != 0) {
+        free(ring->name);
+        free(ring);
+        return NULL;
+    }
+    ring->hdr = (ringbuf_hdr_t*)ring->shm.addr;
+    ring->buf = (char*)ring->shm.addr + RINGBUF_HDR_SIZE;
+    ring->shared = true;
+    ring->owner = true;
+    _ringbuffer_hdr_init(ring->hdr, esize, cap, flags);
+    _ringbuffer_handle_init(ring);
+
+    return ring;
+}
+
+xylem_ringbuf_t* xylem_ringbuf_open_shared(const char* name) {
+    if (!name) {
+        return NULL;
+    }
+    xylem_ringbuf_t* ring = (xylem_ringbuf_t*)malloc(sizeof(xylem_ringbuf_t));
+    if (!ring) {
+        return NULL;
+    }
+    if (platform_shm_open(&ring->shm, name) != 0) {
+        free(ring);
+        return NULL;
+    }
+    ring->hdr = (ringbuf_hdr_t*)ring->shm.addr;
+    ring->buf = (char*)ring->shm.addr + RINGBUF_HDR_SIZE;
+    ring->shared = true;
+    ring->owner = false;
+    ring->name = NULL;
+
+    /* refuse mappings that are not (or not yet) a ring of this layout. */
+    ringbuf_hdr_t* hdr = ring->hdr;
+    if (ring->shm.size < RINGBUF_HDR_SIZE ||
+        atomic_load_explicit(&hdr->magic, memory_order_acquire) !=
+            RINGBUF_MAGIC ||
+        ring->shm.size - RINGBUF_HDR_SIZE <
+            ((size_t)hdr->mask + 1) * (size_t)hdr->esz) {
+        platform_shm_close(&ring->shm);
+        free(ring);
+        return NULL;
+    }
+    _ringbuffer_handle_init(ring);
 
     return ring;
 }
@@ -151,7 +483,15 @@ void xylem_ringbuf_destroy(xylem_ringbuf_t* ring) {
     if (!ring) {
         return;
     }
-    free(ring->buf);
+    if (ring->shared) {
+        platform_shm_close(&ring->shm);
+        if (ring->owner) {
+            platform_shm_unlink(ring->name);
+        }
+        free(ring->name);
+    } else {
+        free(ring->buf);
+    }
     free(ring);
 }
 
@@ -160,11 +500,13 @@ bool xylem_ringbuf_full(xylem_ringbuf_t* ring) {
 }
 
 bool xylem_ringbuf_empty(xylem_ringbuf_t* ring) {
-    return ring->wpos == ring->rpos;
+    return xylem_ringbuf_len(ring) == 0;
 }
 
 size_t xylem_ringbuf_len(xylem_ringbuf_t* ring) {
-    return (size_t)(ring->wpos - ring->rpos);
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_acquire);
+    return (w > r) ? (size_t)(w - r) : 0;
 }
 
 size_t xylem_ringbuf_cap(xylem_ringbuf_t* ring) {
@@ -172,32 +514,207 @@ size_t xylem_ringbuf_cap(xylem_ringbuf_t* ring) {
 }
 
 size_t xylem_ringbuf_avail(xylem_ringbuf_t* ring) {
-    size_t len = xylem_ringbuf_len(ring);
-    size_t cap = xylem_ringbuf_cap(ring);
+    _Atomic uint64_t* head = (ring->flags & XYLEM_RINGBUF_MPSC)
+                                 ? &ring->hdr->whead
+                                 : &ring->hdr->wpos;
+
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+    uint64_t w = atomic_load_explicit(head, memory_order_acquire);
+    size_t   len = (w > r) ? (size_t)(w - r) : 0;
+    size_t   cap = xylem_ringbuf_cap(ring);
     return (len >= cap) ? 0 : (cap - len);
 }
 
 size_t xylem_ringbuf_write(
     xylem_ringbuf_t* ring, const void* buf, size_t entry_count) {
 
-    size_t avail = xylem_ringbuf_avail(ring);
-    if (entry_count > avail) {
-        entry_count = avail;
+    if (ring->flags & XYLEM_RINGBUF_OVERWRITE) {
+        return _ringbuffer_overwrite_write(ring, buf, entry_count);
+    }
+    if (ring->flags & XYLEM_RINGBUF_MPSC) {
+        return _ringbuffer_mpsc_write(ring, buf, entry_count);
     }
-    uint32_t count32 = (uint32_t)entry_count;
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_relaxed);
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+    uint32_t cap = ring->mask + 1;
+    uint32_t count32 = _ringbuffer_clamp_len(cap - (w - r), entry_count);
 
-    _ringbuffer_internal_write(ring, buf, count32, ring->wpos);
-    ring->wpos += count32;
+    if (count32 == 0) {
+        return 0;
+    }
+    _ringbuffer_internal_write(ring, buf, count32, w);
+    atomic_store_explicit(&ring->hdr->wpos, w + count32, memory_order_release);
+    _ringbuffer_notify(ring, &ring->hdr->rwaiters, &ring->hdr->rfutex);
 
-    return entry_count;
+    return (size_t)count32;
 }
 
 size_t
 xylem_ringbuf_read(xylem_ringbuf_t* ring, void* buf, size_t entry_count) {
-    uint32_t count32 = (uint32_t)entry_count;
+    if (ring->flags & XYLEM_RINGBUF_OVERWRITE) {
+        return _ringbuffer_overwrite_read(ring, buf, entry_count);
+    }
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_relaxed);
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_acquire);
+    uint32_t count32 = _ringbuffer_clamp_len(w - r, entry_count);
 
-    uint32_t actual = _ringbuffer_internal_read_peek(ring, buf, count32);
-    ring->rpos += actual;
+    if (count32 == 0) {
+        return 0;
+    }
+    _ringbuffer_internal_read(ring, buf, count32, r);
+    atomic_store_explicit(&ring->hdr->rpos, r + count32, memory_order_release);
+    _ringbuffer_notify(ring, &ring->hdr->wwaiters, &ring->hdr->wfutex);
 
-    return (size_t)actual;
+    return (size_t)count32;
+}
+
+size_t xylem_ringbuf_write_wait(
+    xylem_ringbuf_t* ring,
+    const void*      buf,
+    size_t           entry_count,
+    int              timeout_ms) {
+
+    uint64_t deadline = _ringbuffer_deadline(timeout_ms);
+    size_t   done = 0;
+
+    for (;;) {
+        done += xylem_ringbuf_write(
+            ring,
+            (const char*)buf + done * ring->esz,
+            entry_count - done);
+        if (done == entry_count) {
+            return done;
+        }
+        if (!_ringbuffer_wait(
+                ring,
+                &ring->hdr->wwaiters,
+                &ring->hdr->wfutex,
+                _ringbuffer_writable,
+                deadline)) {
+            return done;
+        }
+    }
+}
+
+size_t xylem_ringbuf_read_wait(
+    xylem_ringbuf_t* ring, void* buf, size_t entry_count, int timeout_ms) {
+
+    uint64_t deadline = _ringbuffer_deadline(timeout_ms);
+
+    for (;;) {
+        size_t n = xylem_ringbuf_read(ring, buf, entry_count);
+        if (n > 0 || entry_count == 0) {
+            return n;
+        }
+        if (!_ringbuffer_wait(
+                ring,
+                &ring->hdr->rwaiters,
+                &ring->hdr->rfutex,
+                _ringbuffer_readable,
+                deadline)) {
+            return 0;
+        }
+    }
+}
+
+size_t
+xylem_ringbuf_snapshot(xylem_ringbuf_t* ring, void* buf, size_t entry_count) {
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_acquire);
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_acquire);
+    uint32_t count32 = _ringbuffer_clamp_len(w - r, entry_count);
+
+    if (count32 > ring->mask + 1) {
+        count32 = ring->mask + 1; /* rpos was stale, the ring lapped it */
+    }
+    uint64_t start = w - count32;
+
+    _ringbuffer_internal_read(ring, buf, count32, start);
+
+    /* entries below the current rpos may have been overwritten while they
+     * were copied; keep only the part that is known to be intact.
+     */
+    atomic_thread_fence(memory_order_acquire);
+    r = atomic_load_explicit(&ring->hdr->rpos, memory_order_relaxed);
+    if (r > start) {
+        uint32_t lost = (r >= w) ? count32 : (uint32_t)(r - start);
+        count32 -= lost;
+        memmove(
+            buf,
+            (char*)buf + (size_t)lost * ring->esz,
+            (size_t)count32 * ring->esz);
+    }
+    return (size_t)count32;
+}
+
+uint64_t xylem_ringbuf_dropped(xylem_ringbuf_t* ring) {
+    return atomic_load_explicit(&ring->hdr->dropped, memory_order_relaxed);
+}
+
+int64_t xylem_ringbuf_read_fd(xylem_ringbuf_t* ring, int fd) {
+    platform_iovec_t iov[2];
+    int              iovcnt;
+
+    if (ring->esz != 1 ||
+        (ring->flags & (XYLEM_RINGBUF_OVERWRITE | XYLEM_RINGBUF_MPSC))) {
+        errno = EINVAL;
+        return -1;
+    }
+    uint64_t w = atomic_load_explicit(&ring->hdr->wpos, memory_order_relaxed);
+    uint32_t avail = (uint32_t)xylem_ringbuf_avail(ring);
+    if (avail == 0) {
+        return 0;
+    }
+    uint32_t idx = (uint32_t)(w & ring->mask);
+    uint32_t cap = ring->mask + 1;
+    uint32_t l = (avail <= cap - idx) ? avail : (cap - idx);
+
+    iov[0].base = ring->buf + idx;
+    iov[0].len = l;
+    iovcnt = 1;
+    if (l < avail) {
+        iov[1].base = ring->buf;
+        iov[1].len = avail - l;
+        iovcnt = 2;
+    }
+    int64_t n = platform_io_readv(fd, iov, iovcnt);
+    if (n > 0) {
+        atomic_store_explicit(
+            &ring->hdr->wpos, w + (uint64_t)n, memory_order_release);
+        _ringbuffer_notify(ring, &ring->hdr->rwaiters, &ring->hdr->rfutex);
+    }
+    return n;
+}
+
+int64_t xylem_ringbuf_write_fd(xylem_ringbuf_t* ring, int fd) {
+    platform_iovec_t iov[2];
+    int              iovcnt;
+
+    if (ring->esz != 1 || (ring->flags & XYLEM_RINGBUF_OVERWRITE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    uint64_t r = atomic_load_explicit(&ring->hdr->rpos, memory_order_relaxed);
+    uint32_t len = (uint32_t)xylem_ringbuf_len(ring);
+    if (len == 0) {
+        return 0;
+    }
+    uint32_t idx = (uint32_t)(r & ring->mask);
+    uint32_t cap = ring->mask + 1;
+    uint32_t l = (len <= cap - idx) ? len : (cap - idx);
+
+    iov[0].base = ring->buf + idx;
+    iov[0].len = l;
+    iovcnt = 1;
+    if (l < len) {
+        iov[1].base = ring->buf;
+        iov[1].len = len - l;
+        iovcnt = 2;
+    }
+    int64_t n = platform_io_writev(fd, iov, iovcnt);
+    if (n > 0) {
+        atomic_store_explicit(
+            &ring->hdr->rpos, r + (uint64_t)n, memory_order_release);
+        _ringbuffer_notify(ring, &ring->hdr->wwaiters, &ring->hdr->wfutex);
+    }
+    return n;
 }
\ No newline at end of file
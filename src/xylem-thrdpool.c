@@ -25,19 +25,32 @@ typedef struct thrdpool_job_s thrdpool_job_t;
 
 struct thrdpool_job_s {
     void (*routine)(void*);
-    void*              arg;
-    xylem_queue_node_t n;
+    void*                  arg;
+    struct thrdpool_job_s* next;
 };
 
 struct xylem_thrdpool_s {
-    thrd_t*       thrds;
-    size_t        thrdcnt;
-    xylem_queue_t queue;
-    mtx_t         mtx;
-    cnd_t         cnd;
-    bool          running;
+    thrd_t*         thrds;
+    size_t          thrdcnt;
+    thrdpool_job_t* head; /* fifo of pending jobs */
+    thrdpool_job_t* tail;
+    mtx_t           mtx;
+    cnd_t           cnd;
+    bool            running;
 };
 
+static thrdpool_job_t* _thrdpool_job_dequeue(xylem_thrdpool_t* pool) {
+    thrdpool_job_t* job = pool->head;
+
+    if (job) {
+        pool->head = job->next;
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+    }
+    return job;
+}
+
 static int _thrdpool_thrdfunc(void* arg) {
     xylem_thrdpool_t* pool = arg;
 
@@ -49,13 +62,10 @@ static int _thrdpool_thrdfunc(void* arg) {
             mtx_unlock(&pool->mtx);
             break;
         }
-        while (pool->running && xylem_queue_empty(&pool->queue)) {
+        while (pool->running && !pool->head) {
             cnd_wait(&pool->cnd, &pool->mtx);
         }
-        xylem_queue_node_t* node = xylem_queue_dequeue(&pool->queue);
-        if (node) {
-            job = xylem_queue_entry(node, thrdpool_job_t, n);
-        }
+        job = _thrdpool_job_dequeue(pool);
         mtx_unlock(&pool->mtx);
 
         if (job) {
@@ -86,7 +96,8 @@ xylem_thrdpool_t* xylem_thrdpool_create(int nthrds) {
     if (!pool) {
         return NULL;
     }
-    xylem_queue_init(&pool->queue);
+    pool->head = NULL;
+    pool->tail = NULL;
     mtx_init(&pool->mtx, mtx_plain);
     cnd_init(&pool->cnd);
 
@@ -96,21 +107,34 @@ xylem_thrdpool_t* xylem_thrdpool_create(int nthrds) {
     for (int i = 0; i < nthrds; i++) {
         _thrdpool_thrd_create(pool);
     }
+    /* a pool without threads would queue jobs that never run. */
+    if (pool->thrdcnt == 0) {
+        xylem_thrdpool_destroy(pool);
+        return NULL;
+    }
     return pool;
 }
 
-void xylem_thrdpool_post(
+int xylem_thrdpool_post(
     xylem_thrdpool_t* restrict pool, void (*routine)(void*), void* arg) {
     thrdpool_job_t* job = malloc(sizeof(thrdpool_job_t));
-    if (job) {
-        job->routine = routine;
-        job->arg = arg;
+    if (!job) {
+        return -1;
+    }
+    job->routine = routine;
+    job->arg = arg;
+    job->next = NULL;
 
-        mtx_lock(&pool->mtx);
-        xylem_queue_enqueue(&pool->queue, &job->n);
-        cnd_signal(&pool->cnd);
-        mtx_unlock(&pool->mtx);
+    mtx_lock(&pool->mtx);
+    if (pool->tail) {
+        pool->tail->next = job;
+    } else {
+        pool->head = job;
     }
+    pool->tail = job;
+    cnd_signal(&pool->cnd);
+    mtx_unlock(&pool->mtx);
+    return 0;
 }
 
 void xylem_thrdpool_destroy(xylem_thrdpool_t* restrict pool) {
@@ -119,14 +143,12 @@ void xylem_thrdpool_destroy(xylem_thrdpool_t* restrict pool) {
     cnd_broadcast(&pool->cnd);
     mtx_unlock(&pool->mtx);
 
-    for (int i = 0; i < pool->thrdcnt; i++) {
+    for (size_t i = 0; i < pool->thrdcnt; i++) {
         thrd_join(pool->thrds[i], NULL);
     }
-    while (!xylem_queue_empty(&pool->queue)) {
-        xylem_queue_node_t* node = xylem_queue_dequeue(&pool->queue);
-        if (node) {
-            free(xylem_queue_entry(node, thrdpool_job_t, n));
-        }
+    thrdpool_job_t* job;
+    while ((job = _thrdpool_job_dequeue(pool)) != NULL) {
+        free(job);
     }
     mtx_destroy(&pool->mtx);
     cnd_destroy(&pool->cnd);
@@ -0,0 +1,223 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "platform/platform.h"
+
+#define TIMEWHEEL_IDLE     -1
+#define TIMEWHEEL_OVERFLOW XYLEM_TIMEWHEEL_LEVELS
+#define TIMEWHEEL_MASK     (XYLEM_TIMEWHEEL_SLOTS - 1)
+#define TIMEWHEEL_SPAN                                                         \
+    ((uint64_t)1 << (XYLEM_TIMEWHEEL_BITS * XYLEM_TIMEWHEEL_LEVELS))
+
+static int _timewheel_cmp(
+    const xylem_heap_node_t* child, const xylem_heap_node_t* parent) {
+    const xylem_timewheel_node_t* c =
+        xylem_heap_entry(child, xylem_timewheel_node_t, heap);
+    const xylem_timewheel_node_t* p =
+        xylem_heap_entry(parent, xylem_timewheel_node_t, heap);
+
+    return c->expire < p->expire ? -1 : c->expire > p->expire;
+}
+
+/* pick the level from the distance to the next unprocessed tick and the
+ * slot from the absolute expiry, so a slot at level l is cascaded exactly
+ * when the wheel reaches the start of its 64^l block.
+ */
+static void _timewheel_link(
+    xylem_timewheel_t* wheel, xylem_timewheel_node_t* node) {
+    uint64_t base = wheel->now + 1;
+    uint64_t expire = node->expire < base ? base : node->expire;
+    uint64_t delta = expire - base;
+    int      level = 0;
+
+    if (delta >= TIMEWHEEL_SPAN) {
+        node->level = TIMEWHEEL_OVERFLOW;
+        xylem_heap_insert(&wheel->overflow, &node->heap);
+        return;
+    }
+    while (delta >> (XYLEM_TIMEWHEEL_BITS * (level + 1))) {
+        level++;
+    }
+    unsigned slot =
+        (unsigned)(expire >> (XYLEM_TIMEWHEEL_BITS * level)) & TIMEWHEEL_MASK;
+
+    node->level = level;
+    node->slot = slot;
+    node->prev = NULL;
+    node->next = wheel->slots[level][slot];
+    if (node->next) {
+        node->next->prev = node;
+    }
+    wheel->slots[level][slot] = node;
+    wheel->masks[level] |= (uint64_t)1 << slot;
+}
+
+static void _timewheel_unlink(
+    xylem_timewheel_t* wheel, xylem_timewheel_node_t* node) {
+    if (node->level == TIMEWHEEL_OVERFLOW) {
+        xylem_heap_remove(&wheel->overflow, &node->heap);
+    } else {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            wheel->slots[node->level][node->slot] = node->next;
+            if (!node->next) {
+                wheel->masks[node->level] &= ~((uint64_t)1 << node->slot);
+            }
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        }
+    }
+    node->level = TIMEWHEEL_IDLE;
+}
+
+/* re-link every node of one slot relative to the current tick. */
+static void _timewheel_cascade(
+    xylem_timewheel_t* wheel, int level, unsigned slot) {
+    xylem_timewheel_node_t* list = wheel->slots[level][slot];
+
+    wheel->slots[level][slot] = NULL;
+    wheel->masks[level] &= ~((uint64_t)1 << slot);
+    while (list) {
+        xylem_timewheel_node_t* next = list->next;
+        _timewheel_link(wheel, list);
+        list = next;
+    }
+}
+
+/* runs at the start of every 64-tick block, with wheel->now one tick
+ * before the block.
+ */
+static void _timewheel_block(xylem_timewheel_t* wheel, uint64_t tick) {
+    for (int level = 1; level < XYLEM_TIMEWHEEL_LEVELS; level++) {
+        unsigned slot = (unsigned)(tick >> (XYLEM_TIMEWHEEL_BITS * level)) &
+                        TIMEWHEEL_MASK;
+        _timewheel_cascade(wheel, level, slot);
+        if (slot != 0) {
+            break;
+        }
+    }
+    for (;;) {
+        xylem_heap_node_t* root = xylem_heap_root(&wheel->overflow);
+        if (!root) {
+            break;
+        }
+        xylem_timewheel_node_t* node =
+            xylem_heap_entry(root, xylem_timewheel_node_t, heap);
+        if (node->expire - tick >= TIMEWHEEL_SPAN) {
+            break;
+        }
+        xylem_heap_dequeue(&wheel->overflow);
+        _timewheel_link(wheel, node);
+    }
+}
+
+void xylem_timewheel_init(xylem_timewheel_t* wheel, uint64_t now) {
+    memset(wheel->slots, 0, sizeof(wheel->slots));
+    memset(wheel->masks, 0, sizeof(wheel->masks));
+    xylem_heap_init(&wheel->overflow, _timewheel_cmp);
+    wheel->now = now;
+    wheel->nelts = 0;
+}
+
+void xylem_timewheel_node_init(xylem_timewheel_node_t* node) {
+    node->expire = 0;
+    node->prev = NULL;
+    node->next = NULL;
+    node->level = TIMEWHEEL_IDLE;
+    node->slot = 0;
+}
+
+void xylem_timewheel_add(
+    xylem_timewheel_t* wheel, xylem_timewheel_node_t* node, uint64_t expire) {
+    if (node->level != TIMEWHEEL_IDLE) {
+        _timewheel_unlink(wheel, node);
+        wheel->nelts -= 1;
+    }
+    node->expire = expire;
+    _timewheel_link(wheel, node);
+    wheel->nelts += 1;
+}
+
+void xylem_timewheel_cancel(
+    xylem_timewheel_t* wheel, xylem_timewheel_node_t* node) {
+    if (node->level != TIMEWHEEL_IDLE) {
+        _timewheel_unlink(wheel, node);
+        wheel->nelts -= 1;
+    }
+}
+
+void xylem_timewheel_reset(
+    xylem_timewheel_t* wheel, xylem_timewheel_node_t* node, uint64_t expire) {
+    xylem_timewheel_add(wheel, node, expire);
+}
+
+bool xylem_timewheel_pending(xylem_timewheel_node_t* node) {
+    return node->level != TIMEWHEEL_IDLE;
+}
+
+bool xylem_timewheel_empty(xylem_timewheel_t* wheel) {
+    return wheel->nelts == 0;
+}
+
+size_t xylem_timewheel_advance(
+    xylem_timewheel_t* wheel,
+    uint64_t           now,
+    void (*cb)(xylem_timewheel_node_t* node, void* arg),
+    void* arg) {
+    size_t fired = 0;
+
+    while (wheel->now < now) {
+        if (wheel->nelts == 0) {
+            wheel->now = now;
+            break;
+        }
+        uint64_t tick = wheel->now + 1;
+        unsigned slot = (unsigned)tick & TIMEWHEEL_MASK;
+
+        if (slot == 0) {
+            _timewheel_block(wheel, tick);
+        } else {
+            /* nothing cascades inside a block, so skip to the next
+             * occupied level-0 slot or the end of the block.
+             */
+            uint64_t bits = wheel->masks[0] >> slot;
+            uint64_t skip = bits ? (uint64_t)platform_ctz64(bits)
+                                 : (uint64_t)(XYLEM_TIMEWHEEL_SLOTS - slot);
+            if (skip > 0) {
+                wheel->now = now - wheel->now > skip ? wheel->now + skip : now;
+                continue;
+            }
+        }
+        wheel->now = tick;
+
+        xylem_timewheel_node_t* node;
+        while ((node = wheel->slots[0][slot]) != NULL) {
+            _timewheel_unlink(wheel, node);
+            wheel->nelts -= 1;
+            fired += 1;
+            cb(node, arg);
+        }
+    }
+    return fired;
+}
\ No newline at end of file
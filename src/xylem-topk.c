@@ -0,0 +1,142 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+
+struct xylem_topk_s {
+    char*  heap; /* min-heap of the kept elements, root is the threshold */
+    char*  tmp;
+    size_t len;
+    size_t k;
+    size_t esz;
+    int (*cmp)(const void* a, const void* b);
+};
+
+#define TOPK_AT(base, i, esz) ((base) + (i) * (esz))
+
+/* sift `elem` down from the root of a min-heap of `n` elements, moving the
+ * hole instead of swapping.
+ */
+static void _topk_sift_down(
+    xylem_topk_t* topk, char* heap, size_t n, const void* elem) {
+    size_t esz = topk->esz;
+    size_t i = 0;
+
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) {
+            break;
+        }
+        if (c + 1 < n &&
+            topk->cmp(TOPK_AT(heap, c + 1, esz), TOPK_AT(heap, c, esz)) < 0) {
+            c += 1;
+        }
+        if (topk->cmp(TOPK_AT(heap, c, esz), elem) >= 0) {
+            break;
+        }
+        memcpy(TOPK_AT(heap, i, esz), TOPK_AT(heap, c, esz), esz);
+        i = c;
+    }
+    memcpy(TOPK_AT(heap, i, esz), elem, esz);
+}
+
+xylem_topk_t* xylem_topk_create(
+    size_t k, size_t esize, int (*cmp)(const void* a, const void* b)) {
+    if (k == 0 || esize == 0 || !cmp || k > SIZE_MAX / esize - 1) {
+        return NULL;
+    }
+    xylem_topk_t* topk = malloc(sizeof(xylem_topk_t));
+    if (!topk) {
+        return NULL;
+    }
+    topk->heap = malloc((k + 1) * esize);
+    if (!topk->heap) {
+        free(topk);
+        return NULL;
+    }
+    topk->tmp = topk->heap + k * esize;
+    topk->len = 0;
+    topk->k = k;
+    topk->esz = esize;
+    topk->cmp = cmp;
+    return topk;
+}
+
+void xylem_topk_destroy(xylem_topk_t* topk) {
+    if (!topk) {
+        return;
+    }
+    free(topk->heap);
+    free(topk);
+}
+
+void xylem_topk_reset(xylem_topk_t* topk) {
+    topk->len = 0;
+}
+
+bool xylem_topk_push(xylem_topk_t* topk, const void* elem) {
+    size_t esz = topk->esz;
+
+    if (topk->len == topk->k) {
+        if (topk->cmp(elem, topk->heap) <= 0) {
+            return false;
+        }
+        _topk_sift_down(topk, topk->heap, topk->len, elem);
+        return true;
+    }
+    /* still filling: sift up from the end. */
+    size_t i = topk->len++;
+    while (i > 0) {
+        size_t p = (i - 1) / 2;
+        if (topk->cmp(TOPK_AT(topk->heap, p, esz), elem) <= 0) {
+            break;
+        }
+        memcpy(TOPK_AT(topk->heap, i, esz), TOPK_AT(topk->heap, p, esz), esz);
+        i = p;
+    }
+    memcpy(TOPK_AT(topk->heap, i, esz), elem, esz);
+    return true;
+}
+
+const void* xylem_topk_threshold(xylem_topk_t* topk) {
+    return topk->len == topk->k ? topk->heap : NULL;
+}
+
+size_t xylem_topk_len(xylem_topk_t* topk) {
+    return topk->len;
+}
+
+size_t xylem_topk_sorted(xylem_topk_t* topk, void* out) {
+    char*  dst = out;
+    size_t esz = topk->esz;
+    size_t n = topk->len;
+
+    /* heapsort a copy: popping a min-heap into its own tail leaves the
+     * array in descending order.
+     */
+    memcpy(dst, topk->heap, n * esz);
+    for (size_t end = n; end > 1; end--) {
+        memcpy(topk->tmp, TOPK_AT(dst, end - 1, esz), esz);
+        memcpy(TOPK_AT(dst, end - 1, esz), dst, esz);
+        _topk_sift_down(topk, dst, end - 1, topk->tmp);
+    }
+    return n;
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+/**
+ * Test that every consumer sees every entry and that the producer is gated
+ * by the slowest consumer.
+ */
+static void test_disruptor_broadcast(void) {
+    xylem_disruptor_t* d =
+        xylem_disruptor_create(sizeof(int), 8 * sizeof(int));
+    ASSERT(d != NULL);
+
+    xylem_disruptor_consumer_t* a = xylem_disruptor_subscribe(d, NULL, 0);
+    xylem_disruptor_consumer_t* b = xylem_disruptor_subscribe(d, NULL, 0);
+    ASSERT(a != NULL && b != NULL);
+
+    int in[12];
+    int out[12];
+    for (int i = 0; i < 12; i++) {
+        in[i] = i;
+    }
+    ASSERT(xylem_disruptor_publish(d, in, 12) == 8);
+    ASSERT(xylem_disruptor_read(a, out, 12) == 8);
+    ASSERT(memcmp(out, in, 8 * sizeof(int)) == 0);
+
+    /* b has not consumed anything, so the ring is still full. */
+    ASSERT(xylem_disruptor_publish(d, in + 8, 4) == 0);
+    ASSERT(xylem_disruptor_read(b, out, 3) == 3);
+    ASSERT(xylem_disruptor_publish(d, in + 8, 4) == 3);
+
+    ASSERT(xylem_disruptor_read(b, out, 12) == 8);
+    ASSERT(memcmp(out, in + 3, 8 * sizeof(int)) == 0);
+    ASSERT(xylem_disruptor_read(a, out, 12) == 3);
+    ASSERT(memcmp(out, in + 8, 3 * sizeof(int)) == 0);
+
+    xylem_disruptor_destroy(d);
+}
+
+/**
+ * Test dependency chains and in-place batch processing: b only sees what
+ * a has released.
+ */
+static void test_disruptor_chain(void) {
+    xylem_disruptor_t* d =
+        xylem_disruptor_create(sizeof(int), 16 * sizeof(int));
+    xylem_disruptor_consumer_t* a = xylem_disruptor_subscribe(d, NULL, 0);
+    xylem_disruptor_consumer_t* b = xylem_disruptor_subscribe(d, &a, 1);
+    int                         in[10];
+
+    for (int i = 0; i < 10; i++) {
+        in[i] = i;
+    }
+    ASSERT(xylem_disruptor_publish(d, in, 10) == 10);
+    ASSERT(xylem_disruptor_poll(b) == 0);
+
+    ASSERT(xylem_disruptor_poll(a) == 10);
+    for (size_t i = 0; i < 6; i++) {
+        int* e = xylem_disruptor_entry(a, i);
+        ASSERT(*e == (int)i);
+        *e *= 10;
+    }
+    ASSERT(xylem_disruptor_entry(a, 10) == NULL);
+    xylem_disruptor_release(a, 6);
+
+    ASSERT(xylem_disruptor_poll(b) == 6);
+    for (size_t i = 0; i < 6; i++) {
+        ASSERT(*(int*)xylem_disruptor_entry(b, i) == (int)i * 10);
+    }
+    xylem_disruptor_release(b, 6);
+    ASSERT(xylem_disruptor_poll(b) == 0);
+
+    /* foreign dependencies are rejected. */
+    xylem_disruptor_t* other =
+        xylem_disruptor_create(sizeof(int), 16 * sizeof(int));
+    ASSERT(xylem_disruptor_subscribe(other, &a, 1) == NULL);
+
+    xylem_disruptor_destroy(other);
+    xylem_disruptor_destroy(d);
+}
+
+/**
+ * Test a dependent consumer registered after publishing started: it starts
+ * at its dependency's position instead of ahead of it.
+ */
+static void test_disruptor_late_subscribe(void) {
+    xylem_disruptor_t* d =
+        xylem_disruptor_create(sizeof(int), 16 * sizeof(int));
+    xylem_disruptor_consumer_t* a = xylem_disruptor_subscribe(d, NULL, 0);
+    int                         in[8];
+
+    for (int i = 0; i < 8; i++) {
+        in[i] = i;
+    }
+    ASSERT(xylem_disruptor_publish(d, in, 8) == 8);
+    ASSERT(xylem_disruptor_poll(a) == 8);
+    xylem_disruptor_release(a, 2);
+
+    xylem_disruptor_consumer_t* b = xylem_disruptor_subscribe(d, &a, 1);
+    ASSERT(b != NULL);
+    ASSERT(xylem_disruptor_poll(b) == 0);
+    ASSERT(xylem_disruptor_entry(b, 0) == NULL);
+
+    xylem_disruptor_release(a, 3);
+    ASSERT(xylem_disruptor_poll(b) == 3);
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT(*(int*)xylem_disruptor_entry(b, i) == (int)i + 2);
+    }
+    ASSERT(xylem_disruptor_read(b, in, 8) == 3);
+    ASSERT(in[0] == 2 && in[2] == 4);
+    ASSERT(xylem_disruptor_poll(b) == 0);
+
+    xylem_disruptor_destroy(d);
+}
+
+#define PIPELINE_TOTAL 100000
+
+typedef struct pipeline_stage_s {
+    xylem_disruptor_consumer_t* consumer;
+    uint64_t                    sum;
+} pipeline_stage_t;
+
+static int _pipeline_stage(void* arg) {
+    pipeline_stage_t* stage = arg;
+    uint64_t          expect = 0;
+
+    while (expect < PIPELINE_TOTAL) {
+        size_t n = xylem_disruptor_poll(stage->consumer);
+        if (n == 0) {
+            thrd_yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint64_t* v = xylem_disruptor_entry(stage->consumer, i);
+            ASSERT(*v == expect);
+            stage->sum += *v;
+            expect++;
+        }
+        xylem_disruptor_release(stage->consumer, n);
+    }
+    return 0;
+}
+
+/**
+ * Test a producer feeding a two-stage pipeline plus an independent
+ * consumer, each on its own thread.
+ */
+static void test_disruptor_threads(void) {
+    xylem_disruptor_t* d =
+        xylem_disruptor_create(sizeof(uint64_t), 64 * sizeof(uint64_t));
+    pipeline_stage_t stages[3] = {0};
+    thrd_t           thrds[3];
+
+    stages[0].consumer = xylem_disruptor_subscribe(d, NULL, 0);
+    stages[1].consumer = xylem_disruptor_subscribe(d, &stages[0].consumer, 1);
+    stages[2].consumer = xylem_disruptor_subscribe(d, NULL, 0);
+
+    for (int i = 0; i < 3; i++) {
+        int ret = thrd_create(&thrds[i], _pipeline_stage, &stages[i]);
+        ASSERT(ret == thrd_success);
+    }
+    for (uint64_t i = 0; i < PIPELINE_TOTAL;) {
+        if (xylem_disruptor_publish(d, &i, 1) == 0) {
+            thrd_yield();
+            continue;
+        }
+        i++;
+    }
+    for (int i = 0; i < 3; i++) {
+        thrd_join(thrds[i], NULL);
+    }
+    uint64_t expect = (uint64_t)PIPELINE_TOTAL * (PIPELINE_TOTAL - 1) / 2;
+    for (int i = 0; i < 3; i++) {
+        ASSERT(stages[i].sum == expect);
+    }
+    xylem_disruptor_destroy(d);
+}
+
+int main(void) {
+    test_disruptor_broadcast();
+    test_disruptor_chain();
+    test_disruptor_late_subscribe();
+    test_disruptor_threads();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#define IN_PATH  "test-extsort-in.bin"
+#define OUT_PATH "test-extsort-out.bin"
+
+typedef struct test_rec_s {
+    uint64_t key;
+    uint64_t id;
+} test_rec_t;
+
+static int _cmp_rec(const void* a, const void* b) {
+    uint64_t x = ((const test_rec_t*)a)->key;
+    uint64_t y = ((const test_rec_t*)b)->key;
+    return x < y ? -1 : x > y;
+}
+
+static void _write_input(size_t n) {
+    FILE*    fp = fopen(IN_PATH, "wb");
+    uint64_t seed = n;
+
+    ASSERT(fp != NULL);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        test_rec_t rec = {.key = seed >> 44, .id = i};
+        ASSERT(fwrite(&rec, sizeof(rec), 1, fp) == 1);
+    }
+    fclose(fp);
+}
+
+/* the output must be sorted and hold every input id exactly once. */
+static void _check_output(size_t n) {
+    FILE*    fp = fopen(OUT_PATH, "rb");
+    uint8_t* seen = calloc(n ? n : 1, 1);
+    uint64_t last = 0;
+    size_t   count = 0;
+
+    ASSERT(fp != NULL && seen != NULL);
+    for (test_rec_t rec; fread(&rec, sizeof(rec), 1, fp) == 1; count++) {
+        ASSERT(rec.key >= last);
+        ASSERT(rec.id < n && !seen[rec.id]);
+        seen[rec.id] = 1;
+        last = rec.key;
+    }
+    ASSERT(count == n);
+    fclose(fp);
+    free(seen);
+}
+
+/**
+ * Test xylem_extsort_file with a budget far below the input size, so runs
+ * are spilled in parallel and merged over several passes.
+ */
+static void test_extsort_multipass(void) {
+    xylem_extsort_opts_t opts = {
+        .memory = 64 * 1024, .nthreads = 3, .iosize = 4000};
+
+    _write_input(200000);
+    ASSERT(
+        xylem_extsort_file(
+            IN_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, &opts) == 0);
+    _check_output(200000);
+
+    opts.tmpdir = ".";
+    ASSERT(
+        xylem_extsort_file(
+            IN_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, &opts) == 0);
+    _check_output(200000);
+}
+
+/**
+ * Test the in-memory path, empty input and malformed input.
+ */
+static void test_extsort_small(void) {
+    _write_input(1000);
+    ASSERT(
+        xylem_extsort_file(
+            IN_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, NULL) == 0);
+    _check_output(1000);
+
+    _write_input(0);
+    ASSERT(
+        xylem_extsort_file(
+            IN_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, NULL) == 0);
+    _check_output(0);
+
+    /* 1000 16-byte records are not a whole number of 24-byte records. */
+    _write_input(1000);
+    ASSERT(xylem_extsort_file(IN_PATH, OUT_PATH, 24, _cmp_rec, NULL) == -1);
+
+    /* failures leave the previous output in place */
+    _write_input(1000);
+    ASSERT(
+        xylem_extsort_file(
+            IN_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, NULL) == 0);
+    ASSERT(
+        xylem_extsort_file(
+            "no-such-file.bin", OUT_PATH, sizeof(test_rec_t), _cmp_rec,
+            NULL) == -1);
+    ASSERT(xylem_extsort_file(IN_PATH, OUT_PATH, 24, _cmp_rec, NULL) == -1);
+    _check_output(1000);
+
+    /* sorting a file onto itself */
+    ASSERT(
+        xylem_extsort_file(
+            OUT_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, NULL) == 0);
+    _check_output(1000);
+    _write_input(5000);
+    remove(OUT_PATH);
+    ASSERT(rename(IN_PATH, OUT_PATH) == 0);
+    xylem_extsort_opts_t opts = {.memory = 16 * 1024, .iosize = 1024};
+    ASSERT(
+        xylem_extsort_file(
+            OUT_PATH, OUT_PATH, sizeof(test_rec_t), _cmp_rec, &opts) == 0);
+    _check_output(5000);
+}
+
+int main(void) {
+    test_extsort_multipass();
+    test_extsort_small();
+    remove(IN_PATH);
+    remove(OUT_PATH);
+    return 0;
+}
\ No newline at end of file
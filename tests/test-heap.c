@@ -151,7 +151,7 @@ static void test_heap_insert_multiple(void) {
 
     xylem_heap_init(&heap, _test_cmp_min);
 
-    for (int i = 0; i < sizeof(items) / sizeof(items[0]); ++i) {
+    for (size_t i = 0; i < sizeof(items) / sizeof(items[0]); ++i) {
         xylem_heap_insert(&heap, &items[i].node);
     }
     ASSERT(heap.nelts == 4);
@@ -213,7 +213,7 @@ static void test_heap_remove_arbitrary(void) {
      *      3   6 5                level 2 (last level, left-filled)
      *
      */
-    for (int i = 0; i < sizeof(items_down) / sizeof(items_down[0]); ++i) {
+    for (size_t i = 0; i < sizeof(items_down) / sizeof(items_down[0]); ++i) {
         xylem_heap_insert(&heap, &items_down[i].node);
     }
     ASSERT(heap.nelts == 6);
@@ -254,7 +254,7 @@ static void test_heap_remove_arbitrary(void) {
      *           / \   /
      *          5   6 7                                level 3
      */
-    for (int i = 0; i < sizeof(items_up) / sizeof(items_up[0]); ++i) {
+    for (size_t i = 0; i < sizeof(items_up) / sizeof(items_up[0]); ++i) {
         xylem_heap_insert(&heap, &items_up[i].node);
     }
     ASSERT(heap.nelts == 10);
@@ -291,6 +291,373 @@ static void test_heap_structure_integrity(void) {
     ASSERT(_validate_heap(&heap));
 }
 
+static void _drain_sorted(xylem_heap_t* heap, size_t expect) {
+    int    last = INT_MIN;
+    size_t count = 0;
+
+    while (!xylem_heap_empty(heap)) {
+        test_item_t* cur =
+            xylem_heap_entry(xylem_heap_root(heap), test_item_t, node);
+        ASSERT(cur->value >= last);
+        last = cur->value;
+        xylem_heap_dequeue(heap);
+        count++;
+    }
+    ASSERT(count == expect);
+}
+
+/**
+ * Test xylem_heap_build: heapifies an unordered array in one pass and the
+ * result is a valid complete heap.
+ */
+static void test_heap_build(void) {
+    static test_item_t        items[500];
+    static xylem_heap_node_t* nodes[500];
+    xylem_heap_t              heap;
+
+    for (int i = 0; i < 500; ++i) {
+        items[i].value = (i * 7919) % 503;
+        nodes[i] = &items[i].node;
+    }
+    xylem_heap_init(&heap, _test_cmp_min);
+    xylem_heap_build(&heap, nodes, 500);
+    ASSERT(heap.nelts == 500);
+    ASSERT(_validate_heap(&heap));
+
+    xylem_heap_build(&heap, nodes, 0);
+    ASSERT(xylem_heap_empty(&heap));
+
+    xylem_heap_build(&heap, nodes, 500);
+    _drain_sorted(&heap, 500);
+}
+
+/**
+ * Test xylem_heap_insert_batch: a large batch takes the rebuild path and a
+ * small one falls back to single inserts; both keep existing nodes.
+ */
+static void test_heap_insert_batch(void) {
+    static test_item_t        items[500];
+    static xylem_heap_node_t* nodes[500];
+    xylem_heap_t              heap;
+
+    for (int i = 0; i < 500; ++i) {
+        items[i].value = (i * 7919) % 503;
+        nodes[i] = &items[i].node;
+    }
+    xylem_heap_init(&heap, _test_cmp_min);
+    for (int i = 0; i < 97; ++i) {
+        xylem_heap_insert(&heap, nodes[i]);
+    }
+    xylem_heap_insert_batch(&heap, nodes + 97, 400);
+    ASSERT(heap.nelts == 497);
+    ASSERT(_validate_heap(&heap));
+
+    xylem_heap_insert_batch(&heap, nodes + 497, 3);
+    ASSERT(heap.nelts == 500);
+    ASSERT(_validate_heap(&heap));
+    _drain_sorted(&heap, 500);
+}
+
+/**
+ * Test xylem_heap_update: raising and lowering keys in place keeps the heap
+ * valid and moves the changed node to its new position.
+ */
+static void test_heap_update(void) {
+    static test_item_t items[200];
+    xylem_heap_t       heap;
+
+    xylem_heap_init(&heap, _test_cmp_min);
+    for (int i = 0; i < 200; ++i) {
+        items[i].value = (i * 37) % 211;
+        xylem_heap_insert(&heap, &items[i].node);
+    }
+    for (int i = 0; i < 200; i += 7) {
+        items[i].value += (i & 1) ? 150 : -150;
+        xylem_heap_update(&heap, &items[i].node);
+        ASSERT(_validate_heap(&heap));
+    }
+    items[123].value = -1000;
+    xylem_heap_update(&heap, &items[123].node);
+    ASSERT(xylem_heap_root(&heap) == &items[123].node);
+
+    items[123].value = 1000;
+    xylem_heap_update(&heap, &items[123].node);
+    ASSERT(_validate_heap(&heap));
+    _drain_sorted(&heap, 200);
+}
+
+typedef struct test_ditem_s {
+    uint64_t           value;
+    xylem_dheap_node_t node;
+} test_ditem_t;
+
+static bool _validate_dheap(const xylem_dheap_t* heap) {
+    for (size_t i = 0; i < heap->nelts; i++) {
+        if (heap->slots[i].node->index != i) {
+            return false;
+        }
+        if (i > 0 && heap->slots[(i - 1) / heap->d].key > heap->slots[i].key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test the d-ary heap for several arities: pseudo-random inserts, removal
+ * of arbitrary nodes, then dequeue in non-decreasing key order.
+ */
+static void test_dheap_order(void) {
+    static test_ditem_t items[1000];
+    size_t              arities[] = {2, 4, 8};
+
+    for (size_t a = 0; a < sizeof(arities) / sizeof(arities[0]); a++) {
+        xylem_dheap_t heap;
+        uint64_t      seed = 12345;
+
+        xylem_dheap_init(&heap, arities[a]);
+        ASSERT(xylem_dheap_empty(&heap));
+        ASSERT(xylem_dheap_root(&heap) == NULL);
+
+        for (size_t i = 0; i < 1000; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            items[i].value = (seed >> 40) % 500;
+            ASSERT(xylem_dheap_insert(
+                       &heap, &items[i].node, items[i].value) == 0);
+        }
+        ASSERT(heap.nelts == 1000);
+        ASSERT(_validate_dheap(&heap));
+
+        for (size_t i = 0; i < 1000; i += 3) {
+            ASSERT(xylem_dheap_key(&heap, &items[i].node) == items[i].value);
+            xylem_dheap_remove(&heap, &items[i].node);
+            ASSERT(_validate_dheap(&heap));
+        }
+        ASSERT(heap.nelts == 1000 - 334);
+
+        for (size_t i = 1; i < 1000; i += 3) {
+            items[i].value = (items[i].value * 31) % 700;
+            xylem_dheap_update(&heap, &items[i].node, items[i].value);
+            ASSERT(_validate_dheap(&heap));
+        }
+
+        uint64_t last = 0;
+        while (!xylem_dheap_empty(&heap)) {
+            test_ditem_t* cur = xylem_heap_entry(
+                xylem_dheap_root(&heap), test_ditem_t, node);
+            ASSERT(cur->value >= last);
+            last = cur->value;
+            xylem_dheap_dequeue(&heap);
+        }
+        xylem_dheap_deinit(&heap);
+    }
+}
+
+typedef struct test_ritem_s {
+    xylem_rheap_node_t node;
+    bool               queued;
+} test_ritem_t;
+
+/**
+ * Test the radix heap with a timer-like workload: keys are always at or
+ * above the last minimum, some nodes are cancelled, and dequeues come out
+ * in non-decreasing order.
+ */
+static void test_rheap_monotone(void) {
+    static test_ritem_t items[2000];
+    xylem_rheap_t       heap;
+    uint64_t            seed = 99;
+    uint64_t            last = 0;
+    size_t              live = 0;
+
+    xylem_rheap_init(&heap);
+    ASSERT(xylem_rheap_empty(&heap));
+    ASSERT(xylem_rheap_root(&heap) == NULL);
+
+    for (int round = 0; round < 20000; round++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        test_ritem_t* it = &items[(seed >> 33) % 2000];
+
+        if (it->queued && (seed & 0x700) == 0) {
+            xylem_rheap_remove(&heap, &it->node);
+            it->queued = false;
+            live--;
+        } else if (!it->queued) {
+            uint64_t delta = (seed >> 8) & ((seed & 1) ? 0xff : 0xfffffff);
+            xylem_rheap_insert(&heap, &it->node, last + delta);
+            it->queued = true;
+            live++;
+        }
+        if (round % 3 == 0 && !xylem_rheap_empty(&heap)) {
+            xylem_rheap_node_t* min = xylem_rheap_root(&heap);
+            ASSERT(min->key >= last);
+            last = min->key;
+            ASSERT(xylem_rheap_last(&heap) == last);
+            xylem_rheap_dequeue(&heap);
+            xylem_heap_entry(min, test_ritem_t, node)->queued = false;
+            live--;
+        }
+        ASSERT(heap.nelts == live);
+    }
+    while (!xylem_rheap_empty(&heap)) {
+        xylem_rheap_node_t* min = xylem_rheap_root(&heap);
+        ASSERT(min->key >= last);
+        last = min->key;
+        xylem_rheap_dequeue(&heap);
+    }
+    ASSERT(xylem_rheap_root(&heap) == NULL);
+
+    /* a key below the last minimum is due immediately. */
+    xylem_rheap_insert(&heap, &items[0].node, last + 10);
+    xylem_rheap_insert(&heap, &items[1].node, last - 5);
+    ASSERT(xylem_rheap_root(&heap) == &items[1].node);
+}
+
+typedef struct test_pitem_s {
+    int                value;
+    xylem_pheap_node_t node;
+} test_pitem_t;
+
+static int _test_pcmp(const xylem_pheap_node_t* a, const xylem_pheap_node_t* b) {
+    int va = xylem_heap_entry(a, test_pitem_t, node)->value;
+    int vb = xylem_heap_entry(b, test_pitem_t, node)->value;
+
+    return va < vb ? -1 : va > vb;
+}
+
+/* check heap order and sibling links below `node`; returns the node count. */
+static size_t _validate_pheap_node(
+    const xylem_pheap_t* heap, const xylem_pheap_node_t* node) {
+    size_t                    count = 1;
+    const xylem_pheap_node_t* prev = node;
+
+    for (xylem_pheap_node_t* c = node->child; c; c = c->next) {
+        ASSERT(c->prev == prev);
+        ASSERT(heap->cmp(c, node) >= 0);
+        count += _validate_pheap_node(heap, c);
+        prev = c;
+    }
+    return count;
+}
+
+static bool _validate_pheap(const xylem_pheap_t* heap) {
+    if (!heap->root) {
+        return heap->nelts == 0;
+    }
+    return heap->root->prev == NULL && heap->root->next == NULL &&
+           _validate_pheap_node(heap, heap->root) == heap->nelts;
+}
+
+/**
+ * Test the pairing heap: insert, decrease-key, arbitrary removal and meld
+ * keep the heap valid, and dequeue returns keys in non-decreasing order.
+ */
+static void test_pheap(void) {
+    static test_pitem_t items[600];
+    xylem_pheap_t       a;
+    xylem_pheap_t       b;
+
+    xylem_pheap_init(&a, _test_pcmp);
+    xylem_pheap_init(&b, _test_pcmp);
+    ASSERT(xylem_pheap_empty(&a));
+    ASSERT(xylem_pheap_root(&a) == NULL);
+
+    for (int i = 0; i < 600; i++) {
+        items[i].value = (i * 7919) % 601;
+        xylem_pheap_insert(i < 300 ? &a : &b, &items[i].node);
+    }
+    /* force some structure before decreasing keys. */
+    xylem_pheap_dequeue(&a);
+    xylem_pheap_dequeue(&b);
+    ASSERT(_validate_pheap(&a) && _validate_pheap(&b));
+
+    for (int i = 1; i < 300; i += 5) {
+        if (&items[i].node == xylem_pheap_root(&a) || items[i].node.prev) {
+            items[i].value -= 400;
+            xylem_pheap_decrease(&a, &items[i].node);
+            ASSERT(_validate_pheap(&a));
+        }
+    }
+    for (int i = 302; i < 600; i += 7) {
+        if (&items[i].node == xylem_pheap_root(&b) || items[i].node.prev) {
+            xylem_pheap_remove(&b, &items[i].node);
+            ASSERT(_validate_pheap(&b));
+        }
+    }
+    size_t total = a.nelts + b.nelts;
+    xylem_pheap_meld(&a, &b);
+    ASSERT(a.nelts == total);
+    ASSERT(xylem_pheap_empty(&b) && b.nelts == 0);
+    ASSERT(_validate_pheap(&a));
+    xylem_pheap_meld(&a, &b);
+    ASSERT(a.nelts == total);
+
+    int last = INT_MIN;
+    while (!xylem_pheap_empty(&a)) {
+        test_pitem_t* cur =
+            xylem_heap_entry(xylem_pheap_root(&a), test_pitem_t, node);
+        int v = cur->value;
+        ASSERT(v >= last);
+        last = v;
+        xylem_pheap_dequeue(&a);
+        total--;
+    }
+    ASSERT(total == 0 && a.nelts == 0);
+}
+
+typedef struct test_timer_s {
+    uint64_t          deadline;
+    xylem_heap_node_t node;
+} test_timer_t;
+
+XYLEM_HEAP_DEFINE(test_timer_heap, test_timer_t, node, deadline)
+
+/**
+ * Test XYLEM_HEAP_DEFINE: the generated heap keeps the intrusive layout,
+ * stays valid through insert/update/remove, and interoperates with the
+ * generic xylem_heap_* functions.
+ */
+static void test_heap_define(void) {
+    static test_timer_t timers[300];
+    xylem_heap_t        heap;
+
+    test_timer_heap_init(&heap);
+    ASSERT(test_timer_heap_root(&heap) == NULL);
+    ASSERT(test_timer_heap_pop(&heap) == NULL);
+
+    for (int i = 0; i < 300; i++) {
+        timers[i].deadline = (uint64_t)((i * 7919) % 307);
+        if (i % 2) {
+            test_timer_heap_insert(&heap, &timers[i]);
+        } else {
+            xylem_heap_insert(&heap, &timers[i].node);
+        }
+    }
+    ASSERT(heap.nelts == 300);
+    ASSERT(_validate_heap(&heap));
+
+    for (int i = 0; i < 300; i += 9) {
+        timers[i].deadline = (timers[i].deadline * 13) % 400;
+        test_timer_heap_update(&heap, &timers[i]);
+        ASSERT(_validate_heap(&heap));
+    }
+    for (int i = 1; i < 300; i += 10) {
+        test_timer_heap_remove(&heap, &timers[i]);
+        ASSERT(_validate_heap(&heap));
+    }
+    ASSERT(heap.nelts == 270);
+
+    uint64_t last = 0;
+    size_t   count = 0;
+    for (test_timer_t* t; (t = test_timer_heap_pop(&heap)) != NULL;) {
+        ASSERT(t->deadline >= last);
+        last = t->deadline;
+        count++;
+    }
+    ASSERT(count == 270);
+    ASSERT(xylem_heap_empty(&heap));
+}
+
 int main(void) {
     test_heap_init();
     test_heap_insert_single();
@@ -299,5 +666,12 @@ int main(void) {
     test_heap_dequeue_all();
     test_heap_remove_arbitrary();
     test_heap_structure_integrity();
+    test_heap_build();
+    test_heap_insert_batch();
+    test_heap_update();
+    test_dheap_order();
+    test_rheap_monotone();
+    test_pheap();
+    test_heap_define();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#define NITEMS  2000
+#define NQUERY  500
+#define SPACE   100000
+
+typedef struct test_item_s {
+    bool               linked;
+    xylem_itree_node_t node;
+} test_item_t;
+
+static test_item_t items[NITEMS];
+
+static uint64_t _rand(uint64_t* seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 33;
+}
+
+static void _random_interval(uint64_t* seed, uint64_t* lo, uint64_t* hi) {
+    *lo = _rand(seed) % SPACE;
+    /* mostly short intervals, a few long ones */
+    *hi = *lo + 1 + (_rand(seed) % 8 == 0 ? _rand(seed) % (SPACE / 4)
+                                           : _rand(seed) % 200);
+}
+
+/* checks the subtree max and returns it. */
+static uint64_t _check_max(const xylem_rbtree_node_t* rb) {
+    if (!rb) {
+        return 0;
+    }
+    const xylem_itree_node_t* n = xylem_rbtree_entry(rb, xylem_itree_node_t, rb);
+    uint64_t                  max = n->hi;
+    uint64_t                  l = _check_max(rb->left);
+    uint64_t                  r = _check_max(rb->right);
+
+    max = l > max ? l : max;
+    max = r > max ? r : max;
+    ASSERT(n->max == max);
+    return max;
+}
+
+/* compare the iterator output against a linear scan over the items. */
+static void _check_query(xylem_itree_iter_t* iter, uint64_t lo, uint64_t hi) {
+    static bool seen[NITEMS];
+    size_t      expect = 0;
+    size_t      got = 0;
+    uint64_t    prev = 0;
+
+    memset(seen, 0, sizeof(seen));
+    for (int i = 0; i < NITEMS; i++) {
+        if (items[i].linked && items[i].node.lo < hi && items[i].node.hi > lo) {
+            expect++;
+        }
+    }
+    for (xylem_itree_node_t* n; (n = xylem_itree_iter_next(iter)) != NULL;) {
+        test_item_t* it = xylem_itree_entry(n, test_item_t, node);
+        size_t       idx = (size_t)(it - items);
+
+        ASSERT(it->linked && !seen[idx]);
+        ASSERT(n->lo < hi && n->hi > lo);
+        ASSERT(n->lo >= prev);
+        seen[idx] = true;
+        prev = n->lo;
+        got++;
+    }
+    ASSERT(got == expect);
+}
+
+/**
+ * Test overlap and stabbing queries against a linear scan while intervals
+ * are inserted and erased.
+ */
+static void test_itree_query(void) {
+    xylem_itree_t      itree;
+    xylem_itree_iter_t iter;
+    uint64_t           seed = 7;
+    uint64_t           lo, hi;
+
+    xylem_itree_init(&itree);
+    xylem_itree_overlap_init(&iter, &itree, 0, SPACE);
+    ASSERT(xylem_itree_iter_next(&iter) == NULL);
+
+    for (int i = 0; i < NITEMS; i++) {
+        _random_interval(&seed, &lo, &hi);
+        xylem_itree_insert(&itree, &items[i].node, lo, hi);
+        items[i].linked = true;
+    }
+    /* duplicates of an existing interval are kept */
+    xylem_itree_erase(&itree, &items[1].node);
+    xylem_itree_insert(&itree, &items[1].node, items[0].node.lo, items[0].node.hi);
+    xylem_itree_stab_init(&iter, &itree, items[0].node.lo);
+    _check_query(&iter, items[0].node.lo, items[0].node.lo + 1);
+
+    for (int round = 0; round < 4; round++) {
+        _check_max(itree.tree.root);
+        for (int q = 0; q < NQUERY; q++) {
+            _random_interval(&seed, &lo, &hi);
+            xylem_itree_overlap_init(&iter, &itree, lo, hi);
+            _check_query(&iter, lo, hi);
+            xylem_itree_stab_init(&iter, &itree, lo);
+            _check_query(&iter, lo, lo + 1);
+        }
+        for (int i = 0; i < NITEMS / 4; i++) {
+            test_item_t* it = &items[_rand(&seed) % NITEMS];
+            if (it->linked) {
+                xylem_itree_erase(&itree, &it->node);
+            } else {
+                _random_interval(&seed, &lo, &hi);
+                xylem_itree_insert(&itree, &it->node, lo, hi);
+            }
+            it->linked = !it->linked;
+        }
+    }
+
+    /* empty query and a query past every interval */
+    xylem_itree_overlap_init(&iter, &itree, 500, 500);
+    ASSERT(xylem_itree_iter_next(&iter) == NULL);
+    xylem_itree_stab_init(&iter, &itree, UINT64_MAX);
+    ASSERT(xylem_itree_iter_next(&iter) == NULL);
+}
+
+/**
+ * Test erasing every overlapping node while iterating.
+ */
+static void test_itree_erase_iter(void) {
+    xylem_itree_t      itree;
+    xylem_itree_iter_t iter;
+    xylem_itree_node_t* n;
+    uint64_t           seed = 11;
+    uint64_t           lo, hi;
+
+    xylem_itree_init(&itree);
+    for (int i = 0; i < NITEMS; i++) {
+        _random_interval(&seed, &lo, &hi);
+        xylem_itree_insert(&itree, &items[i].node, lo, hi);
+        items[i].linked = true;
+    }
+    xylem_itree_overlap_init(&iter, &itree, SPACE / 4, SPACE / 2);
+    while ((n = xylem_itree_iter_next(&iter)) != NULL) {
+        xylem_itree_erase(&itree, n);
+        xylem_itree_entry(n, test_item_t, node)->linked = false;
+    }
+    _check_max(itree.tree.root);
+    xylem_itree_overlap_init(&iter, &itree, SPACE / 4, SPACE / 2);
+    ASSERT(xylem_itree_iter_next(&iter) == NULL);
+    xylem_itree_overlap_init(&iter, &itree, 0, SPACE * 2);
+    _check_query(&iter, 0, SPACE * 2);
+}
+
+int main(void) {
+    test_itree_query();
+    test_itree_erase_iter();
+    return 0;
+}
\ No newline at end of file
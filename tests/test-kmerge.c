@@ -0,0 +1,122 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#define MAX_RUNS 9
+#define RUN_LEN  500
+
+typedef struct test_elem_s {
+    uint32_t key;
+    uint32_t run; /* source run, to check stability */
+    uint32_t idx; /* position in the run */
+} test_elem_t;
+
+typedef struct test_runs_s {
+    test_elem_t data[MAX_RUNS][RUN_LEN];
+    size_t      len[MAX_RUNS];
+    size_t      pos[MAX_RUNS];
+    size_t      refills;
+} test_runs_t;
+
+static test_runs_t runs;
+
+static int _cmp_key(const void* a, const void* b) {
+    uint32_t x = ((const test_elem_t*)a)->key;
+    uint32_t y = ((const test_elem_t*)b)->key;
+    return x < y ? -1 : x > y;
+}
+
+static size_t _refill(void* ctx, size_t run, void* buf, size_t cap) {
+    test_runs_t* r = ctx;
+    size_t       n = r->len[run] - r->pos[run];
+
+    if (n > cap) {
+        n = cap;
+    }
+    memcpy(buf, &r->data[run][r->pos[run]], n * sizeof(test_elem_t));
+    r->pos[run] += n;
+    r->refills++;
+    return n;
+}
+
+static void _make_runs(size_t k) {
+    uint64_t seed = k;
+
+    memset(&runs, 0, sizeof(runs));
+    for (size_t r = 0; r < k; r++) {
+        uint32_t key = 0;
+        /* uneven lengths, one empty run when there are several. */
+        runs.len[r] = (r == 2 && k > 3) ? 0 : RUN_LEN - r * 37;
+        for (size_t i = 0; i < runs.len[r]; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            key += (uint32_t)(seed >> 61);
+            runs.data[r][i].key = key;
+            runs.data[r][i].run = (uint32_t)r;
+            runs.data[r][i].idx = (uint32_t)i;
+        }
+    }
+}
+
+/**
+ * Test xylem_kmerge for several fan-ins: output is sorted, stable across
+ * runs, complete, and runs are read through batched refills.
+ */
+static void test_kmerge_runs(void) {
+    static test_elem_t out[MAX_RUNS * RUN_LEN];
+
+    for (size_t k = 1; k <= MAX_RUNS; k++) {
+        size_t total = 0;
+
+        _make_runs(k);
+        for (size_t r = 0; r < k; r++) {
+            total += runs.len[r];
+        }
+        xylem_kmerge_t* merge = xylem_kmerge_create(
+            k, sizeof(test_elem_t), 16, _cmp_key, _refill, &runs);
+        ASSERT(merge != NULL);
+
+        size_t got = 0;
+        size_t n;
+        while ((n = xylem_kmerge_next(merge, out + got, 7)) > 0) {
+            got += n;
+        }
+        ASSERT(got == total);
+        ASSERT(xylem_kmerge_next(merge, out, 7) == 0);
+        for (size_t i = 1; i < got; i++) {
+            ASSERT(out[i - 1].key <= out[i].key);
+            if (out[i - 1].key == out[i].key) {
+                ASSERT(out[i - 1].run < out[i].run ||
+                       (out[i - 1].run == out[i].run &&
+                        out[i - 1].idx < out[i].idx));
+            }
+        }
+        /* each run is refilled once per 16 elements, plus the final miss. */
+        ASSERT(runs.refills <= total / 16 + 2 * k);
+        xylem_kmerge_destroy(merge);
+    }
+}
+
+int main(void) {
+    test_kmerge_runs();
+    return 0;
+}
\ No newline at end of file
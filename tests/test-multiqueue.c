@@ -0,0 +1,139 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#define NTHREADS 4
+#define PER_THREAD 20000
+
+typedef struct test_task_s {
+    xylem_multiqueue_node_t node;
+    uint64_t                key;
+    _Atomic int             popped;
+} test_task_t;
+
+static test_task_t tasks[NTHREADS * PER_THREAD];
+
+/**
+ * Test single-threaded push/pop: every node comes back exactly once with
+ * its key, and pops are roughly ordered.
+ */
+static void test_multiqueue_basic(void) {
+    xylem_multiqueue_t* mq = xylem_multiqueue_create(4);
+    uint64_t            key;
+    uint64_t            sum = 0;
+
+    ASSERT(mq != NULL);
+    ASSERT(xylem_multiqueue_pop(mq, &key) == NULL);
+
+    for (size_t i = 0; i < 1000; i++) {
+        tasks[i].key = (i * 7919) % 1000;
+        atomic_init(&tasks[i].popped, 0);
+        ASSERT(xylem_multiqueue_push(mq, &tasks[i].node, tasks[i].key) == 0);
+    }
+    ASSERT(xylem_multiqueue_len(mq) == 1000);
+
+    for (size_t i = 0; i < 1000; i++) {
+        xylem_multiqueue_node_t* n = xylem_multiqueue_pop(mq, &key);
+        ASSERT(n != NULL);
+        test_task_t* t = xylem_multiqueue_entry(n, test_task_t, node);
+        ASSERT(t->key == key);
+        ASSERT(atomic_fetch_add(&t->popped, 1) == 0);
+        /* with 4 heaps the first pops must come from the low end. */
+        if (i < 10) {
+            ASSERT(key < 200);
+        }
+        sum += key;
+    }
+    ASSERT(sum == 999 * 1000 / 2);
+    ASSERT(xylem_multiqueue_pop(mq, NULL) == NULL);
+    ASSERT(xylem_multiqueue_len(mq) == 0);
+    xylem_multiqueue_destroy(mq);
+}
+
+typedef struct test_worker_s {
+    xylem_multiqueue_t* mq;
+    size_t              id;
+    size_t              popped;
+} test_worker_t;
+
+static int _worker(void* arg) {
+    test_worker_t* w = arg;
+
+    for (size_t i = 0; i < PER_THREAD; i++) {
+        test_task_t* t = &tasks[w->id * PER_THREAD + i];
+        ASSERT(xylem_multiqueue_push(w->mq, &t->node, t->key) == 0);
+        if (i % 2 == 1) {
+            xylem_multiqueue_node_t* n = xylem_multiqueue_pop(w->mq, NULL);
+            if (n) {
+                t = xylem_multiqueue_entry(n, test_task_t, node);
+                ASSERT(atomic_fetch_add(&t->popped, 1) == 0);
+                w->popped++;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Test concurrent producers/consumers: no node is lost or popped twice.
+ */
+static void test_multiqueue_threads(void) {
+    xylem_multiqueue_t* mq = xylem_multiqueue_create(NTHREADS * 2);
+    test_worker_t       workers[NTHREADS];
+    thrd_t              thrds[NTHREADS];
+    size_t              popped = 0;
+
+    for (size_t i = 0; i < NTHREADS * PER_THREAD; i++) {
+        tasks[i].key = (i * 2654435761u) % 100000;
+        atomic_init(&tasks[i].popped, 0);
+    }
+    for (size_t i = 0; i < NTHREADS; i++) {
+        workers[i].mq = mq;
+        workers[i].id = i;
+        workers[i].popped = 0;
+        int ret = thrd_create(&thrds[i], _worker, &workers[i]);
+        ASSERT(ret == thrd_success);
+    }
+    for (size_t i = 0; i < NTHREADS; i++) {
+        thrd_join(thrds[i], NULL);
+        popped += workers[i].popped;
+    }
+    ASSERT(xylem_multiqueue_len(mq) == NTHREADS * PER_THREAD - popped);
+    xylem_multiqueue_node_t* n;
+    while ((n = xylem_multiqueue_pop(mq, NULL)) != NULL) {
+        test_task_t* t = xylem_multiqueue_entry(n, test_task_t, node);
+        ASSERT(atomic_fetch_add(&t->popped, 1) == 0);
+        popped++;
+    }
+    ASSERT(popped == NTHREADS * PER_THREAD);
+    for (size_t i = 0; i < NTHREADS * PER_THREAD; i++) {
+        ASSERT(atomic_load(&tasks[i].popped) == 1);
+    }
+    xylem_multiqueue_destroy(mq);
+}
+
+int main(void) {
+    test_multiqueue_basic();
+    test_multiqueue_threads();
+    return 0;
+}
\ No newline at end of file
@@ -1,7 +1,578 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
 #include "xylem.h"
 #include "assert.h"
 
+#define NITEMS 2000
+
+typedef struct test_item_s {
+    int                 key;
+    bool                linked;
+    xylem_rbtree_node_t node;
+} test_item_t;
+
+static test_item_t items[NITEMS];
+
+static int _cmp_nn(const xylem_rbtree_node_t* a, const xylem_rbtree_node_t* b) {
+    int x = xylem_rbtree_entry(a, test_item_t, node)->key;
+    int y = xylem_rbtree_entry(b, test_item_t, node)->key;
+    return x < y ? -1 : x > y;
+}
+
+static int _cmp_kn(const void* key, const xylem_rbtree_node_t* n) {
+    int x = *(const int*)key;
+    int y = xylem_rbtree_entry(n, test_item_t, node)->key;
+    return x < y ? -1 : x > y;
+}
+
+static int _key(const xylem_rbtree_node_t* n) {
+    return xylem_rbtree_entry(n, test_item_t, node)->key;
+}
+
+/* returns the black height, checks red-black and ordering invariants. */
+static int _check_node(const xylem_rbtree_node_t* n, size_t* count) {
+    if (!n) {
+        return 1;
+    }
+    (*count)++;
+    if (n->left) {
+        ASSERT(xylem_rbtree_parent(n->left) == n);
+        ASSERT(_key(n->left) < _key(n));
+    }
+    if (n->right) {
+        ASSERT(xylem_rbtree_parent(n->right) == n);
+        ASSERT(_key(n->right) > _key(n));
+    }
+    if (xylem_rbtree_color(n) == 0) {
+        ASSERT(!n->left || xylem_rbtree_color(n->left) != 0);
+        ASSERT(!n->right || xylem_rbtree_color(n->right) != 0);
+    }
+    int lh = _check_node(n->left, count);
+    int rh = _check_node(n->right, count);
+    ASSERT(lh == rh);
+    return lh + (xylem_rbtree_color(n) != 0);
+}
+
+static size_t _check_tree(xylem_rbtree_t* tree) {
+    size_t count = 0;
+
+    if (tree->root) {
+        ASSERT(xylem_rbtree_parent(tree->root) == NULL);
+        ASSERT(xylem_rbtree_color(tree->root) != 0);
+    }
+    _check_node(tree->root, &count);
+
+    xylem_rbtree_node_t* first = tree->root;
+    xylem_rbtree_node_t* last = tree->root;
+    while (first && first->left) {
+        first = first->left;
+    }
+    while (last && last->right) {
+        last = last->right;
+    }
+    ASSERT(xylem_rbtree_first(tree) == first);
+    ASSERT(xylem_rbtree_last(tree) == last);
+    return count;
+}
+
+static uint64_t _rand(uint64_t* seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 33;
+}
+
+/* fill the tree with even keys 0, 2, ..., 2 * (NITEMS - 1) in random order. */
+static void _fill(xylem_rbtree_t* tree, uint64_t seed) {
+    xylem_rbtree_init(tree, _cmp_nn, _cmp_kn);
+    for (int i = 0; i < NITEMS; i++) {
+        items[i].key = 2 * i;
+        items[i].linked = false;
+    }
+    for (int i = NITEMS - 1; i > 0; i--) {
+        int j = (int)(_rand(&seed) % (uint64_t)(i + 1));
+        int t = items[i].key;
+        items[i].key = items[j].key;
+        items[j].key = t;
+    }
+    for (int i = 0; i < NITEMS; i++) {
+        xylem_rbtree_insert(tree, &items[i].node);
+        items[i].linked = true;
+    }
+}
+
+/**
+ * Test insert/erase keep the red-black invariants and the cached first
+ * and last nodes correct.
+ */
+static void test_rbtree_insert_erase(void) {
+    xylem_rbtree_t tree;
+    uint64_t       seed = 17;
+
+#if defined(XYLEM_RBTREE_COMPACT)
+    ASSERT(sizeof(xylem_rbtree_node_t) == 3 * sizeof(void*));
+#endif
+    _fill(&tree, 1);
+    ASSERT(_check_tree(&tree) == NITEMS);
+    ASSERT(_key(xylem_rbtree_first(&tree)) == 0);
+    ASSERT(_key(xylem_rbtree_last(&tree)) == 2 * (NITEMS - 1));
+
+    size_t live = NITEMS;
+    for (int round = 0; round < 3 * NITEMS; round++) {
+        test_item_t* it = &items[_rand(&seed) % NITEMS];
+        if (it->linked) {
+            xylem_rbtree_erase(&tree, &it->node);
+            live--;
+        } else {
+            xylem_rbtree_insert(&tree, &it->node);
+            live++;
+        }
+        it->linked = !it->linked;
+        if (round % 97 == 0) {
+            ASSERT(_check_tree(&tree) == live);
+        }
+    }
+    ASSERT(_check_tree(&tree) == live);
+
+    while (!xylem_rbtree_empty(&tree)) {
+        xylem_rbtree_erase(&tree, xylem_rbtree_first(&tree));
+    }
+    ASSERT(xylem_rbtree_first(&tree) == NULL);
+    ASSERT(xylem_rbtree_last(&tree) == NULL);
+}
+
+/**
+ * Test lower_bound/upper_bound on present keys, gaps and both ends.
+ */
+static void test_rbtree_bounds(void) {
+    xylem_rbtree_t tree;
+
+    _fill(&tree, 2);
+    for (int k = -3; k <= 2 * NITEMS + 1; k++) {
+        xylem_rbtree_node_t* lb = xylem_rbtree_lower_bound(&tree, &k);
+        xylem_rbtree_node_t* ub = xylem_rbtree_upper_bound(&tree, &k);
+        int                  lk = k <= 0 ? 0 : (k + 1) / 2 * 2;
+        int                  uk = k < 0 ? 0 : k / 2 * 2 + 2;
+
+        if (lk > 2 * (NITEMS - 1)) {
+            ASSERT(lb == NULL);
+        } else {
+            ASSERT(lb && _key(lb) == lk);
+        }
+        if (uk > 2 * (NITEMS - 1)) {
+            ASSERT(ub == NULL);
+        } else {
+            ASSERT(ub && _key(ub) == uk);
+        }
+    }
+}
+
+/**
+ * Test find_batch against find for hits and misses, batch sizes around
+ * the lane count, and an empty tree.
+ */
+static void test_rbtree_find_batch(void) {
+    static int                  keys[3 * NITEMS];
+    static const void*          kp[3 * NITEMS];
+    static xylem_rbtree_node_t* out[3 * NITEMS];
+    xylem_rbtree_t              tree;
+    uint64_t                    seed = 3;
+
+    for (size_t i = 0; i < 3 * NITEMS; i++) {
+        keys[i] = (int)(_rand(&seed) % (2 * NITEMS + 10)) - 5;
+        kp[i] = &keys[i];
+    }
+    _fill(&tree, 6);
+    for (size_t n = 0; n <= 3 * NITEMS; n = n < 20 ? n + 1 : n * 3) {
+        size_t found = 0;
+
+        ASSERT(xylem_rbtree_find_batch(&tree, kp, n, out) <= n);
+        for (size_t i = 0; i < n; i++) {
+            ASSERT(out[i] == xylem_rbtree_find(&tree, kp[i]));
+            found += out[i] != NULL;
+        }
+        ASSERT(xylem_rbtree_find_batch(&tree, kp, n, out) == found);
+    }
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    out[0] = &items[0].node;
+    ASSERT(xylem_rbtree_find_batch(&tree, kp, 1, out) == 0);
+    ASSERT(out[0] == NULL);
+}
+
+/**
+ * Test range iteration over [lo, hi), open ends, and erasing each node as
+ * it is returned.
+ */
+static void test_rbtree_range(void) {
+    xylem_rbtree_t       tree;
+    xylem_rbtree_range_t range;
+    xylem_rbtree_node_t* n;
+    int                  lo = 101;
+    int                  hi = 300;
+    int                  expect = 102;
+
+    _fill(&tree, 3);
+    xylem_rbtree_range_init(&range, &tree, &lo, &hi);
+    while ((n = xylem_rbtree_range_next(&range)) != NULL) {
+        ASSERT(_key(n) == expect);
+        expect += 2;
+    }
+    ASSERT(expect == 300);
+
+    hi = 10;
+    xylem_rbtree_range_init(&range, &tree, NULL, &hi);
+    for (expect = 0; (n = xylem_rbtree_range_next(&range)) != NULL;) {
+        ASSERT(_key(n) == expect);
+        expect += 2;
+    }
+    ASSERT(expect == 10);
+
+    lo = 2 * NITEMS - 5;
+    xylem_rbtree_range_init(&range, &tree, &lo, NULL);
+    for (expect = lo + 1; (n = xylem_rbtree_range_next(&range)) != NULL;) {
+        ASSERT(_key(n) == expect);
+        expect += 2;
+    }
+    ASSERT(expect == 2 * NITEMS);
+
+    /* empty range */
+    lo = 50;
+    hi = 50;
+    xylem_rbtree_range_init(&range, &tree, &lo, &hi);
+    ASSERT(xylem_rbtree_range_next(&range) == NULL);
+
+    /* erase while iterating */
+    lo = 1000;
+    hi = 2000;
+    xylem_rbtree_range_init(&range, &tree, &lo, &hi);
+    while ((n = xylem_rbtree_range_next(&range)) != NULL) {
+        xylem_rbtree_erase(&tree, n);
+    }
+    ASSERT(_check_tree(&tree) == NITEMS - 500);
+    ASSERT(xylem_rbtree_find(&tree, &lo) == NULL);
+    ASSERT(_key(xylem_rbtree_lower_bound(&tree, &lo)) == 2000);
+}
+
+/**
+ * Test insert_unique reports collisions and insert_hint links correctly
+ * for right, wrong and missing hints, including nearly sorted input.
+ */
+static void test_rbtree_insert_unique_hint(void) {
+    xylem_rbtree_t       tree;
+    xylem_rbtree_node_t* hint = NULL;
+    test_item_t          dup;
+    uint64_t             seed = 5;
+
+    _fill(&tree, 4);
+    dup.key = 2 * 7;
+    ASSERT(_key(xylem_rbtree_insert_unique(&tree, &dup.node)) == 14);
+    ASSERT(xylem_rbtree_insert_hint(&tree, &dup.node, NULL) != NULL);
+    ASSERT(_check_tree(&tree) == NITEMS);
+
+    /* nearly sorted: mostly ascending, with occasional small swaps */
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    for (int i = 0; i < NITEMS; i++) {
+        items[i].key = i;
+    }
+    for (int i = 1; i < NITEMS; i++) {
+        if (_rand(&seed) % 8 == 0) {
+            int t = items[i].key;
+            items[i].key = items[i - 1].key;
+            items[i - 1].key = t;
+        }
+    }
+    for (int i = 0; i < NITEMS; i++) {
+        ASSERT(xylem_rbtree_insert_hint(&tree, &items[i].node, hint) == NULL);
+        hint = &items[i].node;
+        if (i % 131 == 0) {
+            _check_tree(&tree);
+        }
+    }
+    ASSERT(_check_tree(&tree) == NITEMS);
+    for (int i = 0; i < NITEMS; i++) {
+        dup.key = items[i].key;
+        ASSERT(xylem_rbtree_insert_hint(&tree, &dup.node, &items[i].node) ==
+               &items[i].node);
+        ASSERT(xylem_rbtree_insert_unique(&tree, &dup.node) == &items[i].node);
+    }
+
+    /* random keys with random (mostly wrong) hints fall back correctly */
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    for (int i = 0; i < NITEMS; i++) {
+        items[i].key = (int)(_rand(&seed) % (2 * NITEMS));
+        int j = i ? (int)(_rand(&seed) % (uint64_t)i) : 0;
+        hint = i && items[j].linked ? &items[j].node : NULL;
+        items[i].linked =
+            xylem_rbtree_insert_hint(&tree, &items[i].node, hint) == NULL;
+    }
+    size_t live = 0;
+    for (int i = 0; i < NITEMS; i++) {
+        live += items[i].linked;
+    }
+    ASSERT(_check_tree(&tree) == live);
+}
+
+/**
+ * Test build_sorted yields a valid tree for every small size and for a
+ * large one, and that the tree accepts updates afterwards.
+ */
+static void test_rbtree_build_sorted(void) {
+    static xylem_rbtree_node_t* nodes[NITEMS];
+    xylem_rbtree_t              tree;
+
+    xylem_rbtree_init(&tree, _cmp_nn, _cmp_kn);
+    for (int i = 0; i < NITEMS; i++) {
+        items[i].key = 2 * i;
+        nodes[i] = &items[i].node;
+    }
+    for (size_t n = 0; n <= 130; n++) {
+        xylem_rbtree_build_sorted(&tree, nodes, n);
+        ASSERT(_check_tree(&tree) == n);
+    }
+    xylem_rbtree_build_sorted(&tree, nodes, NITEMS);
+    ASSERT(_check_tree(&tree) == NITEMS);
+    for (int k = 0; k < 2 * NITEMS; k += 2) {
+        ASSERT(_key(xylem_rbtree_find(&tree, &k)) == k);
+    }
+    for (int i = 0; i < NITEMS; i += 3) {
+        xylem_rbtree_erase(&tree, &items[i].node);
+    }
+    ASSERT(_check_tree(&tree) == NITEMS - (NITEMS + 2) / 3);
+}
+
+/**
+ * Test split at every kind of key, join of trees of very different
+ * heights, and extract of open and closed ranges.
+ */
+static void test_rbtree_split_join(void) {
+    xylem_rbtree_t tree, left, right, out;
+    uint64_t       seed = 31;
+
+    for (int round = 0; round < 200; round++) {
+        int key = (int)(_rand(&seed) % (2 * NITEMS + 4)) - 2;
+
+        _fill(&tree, (uint64_t)round);
+        xylem_rbtree_split(&tree, &key, &left, &right);
+        ASSERT(xylem_rbtree_empty(&tree));
+
+        size_t nl = _check_tree(&left);
+        size_t nr = _check_tree(&right);
+        size_t expect = key <= 0 ? 0 : (size_t)(key + 1) / 2;
+        ASSERT(nl + nr == NITEMS);
+        ASSERT(nl == (expect > NITEMS ? NITEMS : expect));
+        ASSERT(!nl || _key(xylem_rbtree_last(&left)) < key);
+        ASSERT(!nr || _key(xylem_rbtree_first(&right)) >= key);
+
+        xylem_rbtree_join(&left, &right);
+        ASSERT(xylem_rbtree_empty(&right));
+        ASSERT(_check_tree(&left) == NITEMS);
+        int k = 0;
+        for (xylem_rbtree_node_t* n = xylem_rbtree_first(&left); n;
+             n = xylem_rbtree_next(n), k += 2) {
+            ASSERT(_key(n) == k);
+        }
+    }
+
+    /* lopsided join: a few nodes on either side of a big tree */
+    _fill(&tree, 9);
+    int key = 6;
+    xylem_rbtree_split(&tree, &key, &tree, &right);
+    ASSERT(_check_tree(&tree) == 3);
+    xylem_rbtree_join(&tree, &right);
+    ASSERT(_check_tree(&tree) == NITEMS);
+    key = 2 * NITEMS - 6;
+    xylem_rbtree_split(&tree, &key, &left, &tree);
+    ASSERT(_check_tree(&tree) == 3);
+    xylem_rbtree_join(&left, &tree);
+    ASSERT(_check_tree(&left) == NITEMS);
+
+    /* extract [lo, hi), then open-ended ranges */
+    int lo = 101;
+    int hi = 1001;
+    xylem_rbtree_extract(&left, &lo, &hi, &out);
+    ASSERT(_check_tree(&out) == 450);
+    ASSERT(_check_tree(&left) == NITEMS - 450);
+    ASSERT(_key(xylem_rbtree_first(&out)) == 102);
+    ASSERT(_key(xylem_rbtree_last(&out)) == 1000);
+    ASSERT(xylem_rbtree_find(&left, &(int){500}) == NULL);
+
+    xylem_rbtree_extract(&left, NULL, &lo, &out);
+    ASSERT(_check_tree(&out) == 51);
+    xylem_rbtree_extract(&left, &hi, NULL, &out);
+    ASSERT(_check_tree(&out) == NITEMS - 501);
+    ASSERT(_check_tree(&left) == 0);
+}
+
+XYLEM_RBTREE_DEFINE(test_map, test_item_t, node, key, int, XYLEM_RBTREE_CMP)
+
+/**
+ * Test XYLEM_RBTREE_DEFINE: the generated insert/find/erase agree with the
+ * generic calls on the same tree.
+ */
+static void test_rbtree_define(void) {
+    xylem_rbtree_t tree;
+    test_item_t    dup;
+    uint64_t       seed = 13;
+
+    test_map_init(&tree);
+    for (int i = 0; i < NITEMS; i++) {
+        items[i].key = 2 * i;
+    }
+    for (int i = NITEMS - 1; i > 0; i--) {
+        int j = (int)(_rand(&seed) % (uint64_t)(i + 1));
+        int t = items[i].key;
+        items[i].key = items[j].key;
+        items[j].key = t;
+    }
+    for (int i = 0; i < NITEMS; i++) {
+        ASSERT(test_map_insert(&tree, &items[i]) == NULL);
+    }
+    ASSERT(_check_tree(&tree) == NITEMS);
+    dup.key = 2 * 11;
+    ASSERT(test_map_insert(&tree, &dup)->key == 2 * 11);
+
+    for (int k = -1; k <= 2 * NITEMS; k++) {
+        test_item_t* it = test_map_find(&tree, k);
+        ASSERT(it ? it->key == k : (k & 1) || k < 0 || k >= 2 * NITEMS);
+        ASSERT((it ? &it->node : NULL) == xylem_rbtree_find(&tree, &k));
+    }
+    for (int i = 0; i < NITEMS; i += 2) {
+        test_map_erase(&tree, &items[i]);
+    }
+    ASSERT(_check_tree(&tree) == NITEMS / 2);
+    for (int i = 0; i < NITEMS; i++) {
+        ASSERT((test_map_find(&tree, items[i].key) != NULL) == (i & 1));
+    }
+}
+
+typedef struct test_sitem_s {
+    int                  key;
+    bool                 linked;
+    xylem_rbtree_snode_t snode;
+} test_sitem_t;
+
+static test_sitem_t sitems[NITEMS];
+
+static int _skey(const xylem_rbtree_node_t* n) {
+    return xylem_rbtree_entry(n, test_sitem_t, snode.node)->key;
+}
+
+static int
+_scmp_nn(const xylem_rbtree_node_t* a, const xylem_rbtree_node_t* b) {
+    int x = _skey(a);
+    int y = _skey(b);
+    return x < y ? -1 : x > y;
+}
+
+static int _scmp_kn(const void* key, const xylem_rbtree_node_t* n) {
+    int x = *(const int*)key;
+    int y = _skey(n);
+    return x < y ? -1 : x > y;
+}
+
+static size_t _check_size(const xylem_rbtree_node_t* n) {
+    if (!n) {
+        return 0;
+    }
+    size_t size = 1 + _check_size(n->left) + _check_size(n->right);
+    ASSERT(xylem_rbtree_entry(n, xylem_rbtree_snode_t, node)->size == size);
+    return size;
+}
+
+/**
+ * Test the subtree sizes survive random insert/erase, and select/rank
+ * agree with in-order position.
+ */
+static void test_rbtree_select_rank(void) {
+    xylem_rbtree_t tree;
+    uint64_t       seed = 23;
+    size_t         live = 0;
+
+    xylem_rbtree_init_augmented(
+        &tree, _scmp_nn, _scmp_kn, xylem_rbtree_size_augment);
+    for (int i = 0; i < NITEMS; i++) {
+        sitems[i].key = i;
+        sitems[i].linked = false;
+    }
+    for (int round = 0; round < 4 * NITEMS; round++) {
+        test_sitem_t* it = &sitems[_rand(&seed) % NITEMS];
+        if (it->linked) {
+            xylem_rbtree_erase(&tree, &it->snode.node);
+            live--;
+        } else if (round & 1) {
+            xylem_rbtree_insert(&tree, &it->snode.node);
+            live++;
+        } else {
+            ASSERT(xylem_rbtree_insert_hint(
+                       &tree, &it->snode.node, xylem_rbtree_last(&tree)) ==
+                   NULL);
+            live++;
+        }
+        it->linked = !it->linked;
+        if (round % 89 == 0) {
+            ASSERT(_check_size(tree.root) == live);
+        }
+    }
+    ASSERT(_check_size(tree.root) == live);
+
+    size_t k = 0;
+    for (xylem_rbtree_node_t* n = xylem_rbtree_first(&tree); n;
+         n = xylem_rbtree_next(n), k++) {
+        ASSERT(xylem_rbtree_select(&tree, k) == n);
+        ASSERT(xylem_rbtree_rank(n) == k);
+    }
+    ASSERT(k == live);
+    ASSERT(xylem_rbtree_select(&tree, live) == NULL);
+
+    /* build_sorted fills in the sizes as well */
+    static xylem_rbtree_node_t* nodes[NITEMS];
+    for (int i = 0; i < NITEMS; i++) {
+        sitems[i].key = i;
+        nodes[i] = &sitems[i].snode.node;
+    }
+    xylem_rbtree_build_sorted(&tree, nodes, NITEMS);
+    ASSERT(_check_size(tree.root) == NITEMS);
+    ASSERT(_skey(xylem_rbtree_select(&tree, 1234)) == 1234);
+
+    /* split and join keep the sizes */
+    xylem_rbtree_t right;
+    int            key = 777;
+    xylem_rbtree_split(&tree, &key, &tree, &right);
+    ASSERT(_check_size(tree.root) == 777);
+    ASSERT(_check_size(right.root) == NITEMS - 777);
+    ASSERT(_skey(xylem_rbtree_select(&right, 0)) == 777);
+    xylem_rbtree_join(&tree, &right);
+    ASSERT(_check_size(tree.root) == NITEMS);
+    ASSERT(xylem_rbtree_rank(&sitems[1500].snode.node) == 1500);
+}
+
 int main(void) {
-	
-	return 0;
+    test_rbtree_insert_erase();
+    test_rbtree_bounds();
+    test_rbtree_find_batch();
+    test_rbtree_range();
+    test_rbtree_insert_unique_hint();
+    test_rbtree_build_sorted();
+    test_rbtree_split_join();
+    test_rbtree_define();
+    test_rbtree_select_rank();
+    return 0;
 }
\ No newline at end of file
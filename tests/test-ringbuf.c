@@ -0,0 +1,532 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define pipe(fds) _pipe((fds), 65536, _O_BINARY)
+#define close _close
+#define read _read
+#define write _write
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+typedef struct test_pair_s {
+    uint32_t a;
+    uint16_t b;
+} test_pair_t;
+
+XYLEM_RINGBUF_DEFINE(test_ring, test_pair_t, 8)
+
+/**
+ * Test xylem_ringbuf_create: capacity is rounded down to a power of two
+ * and invalid sizes are rejected.
+ */
+static void test_ringbuf_create(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create(1, 100);
+    ASSERT(ring != NULL);
+    ASSERT(xylem_ringbuf_cap(ring) == 64);
+    ASSERT(xylem_ringbuf_len(ring) == 0);
+    ASSERT(xylem_ringbuf_avail(ring) == 64);
+    ASSERT(xylem_ringbuf_empty(ring));
+    ASSERT(!xylem_ringbuf_full(ring));
+    xylem_ringbuf_destroy(ring);
+
+    ASSERT(xylem_ringbuf_create(0, 100) == NULL);
+    ASSERT(xylem_ringbuf_create(8, 4) == NULL);
+    xylem_ringbuf_destroy(NULL);
+}
+
+/**
+ * Test write/read round trip across the wrap point, including truncation
+ * of writes and reads to what the ring can hold.
+ */
+static void test_ringbuf_write_read(void) {
+    xylem_ringbuf_t* ring =
+        xylem_ringbuf_create(sizeof(uint32_t), 8 * sizeof(uint32_t));
+    uint32_t in[12];
+    uint32_t out[12];
+
+    for (uint32_t i = 0; i < 12; i++) {
+        in[i] = i + 1;
+    }
+    ASSERT(xylem_ringbuf_write(ring, in, 6) == 6);
+    ASSERT(xylem_ringbuf_read(ring, out, 4) == 4);
+    ASSERT(memcmp(out, in, 4 * sizeof(uint32_t)) == 0);
+
+    /* 2 entries buffered, 6 free: the write fills the ring and wraps. */
+    ASSERT(xylem_ringbuf_write(ring, in + 6, 6) == 6);
+    ASSERT(xylem_ringbuf_full(ring));
+    ASSERT(xylem_ringbuf_write(ring, in, 1) == 0);
+
+    ASSERT(xylem_ringbuf_read(ring, out, 12) == 8);
+    ASSERT(memcmp(out, in + 4, 8 * sizeof(uint32_t)) == 0);
+    ASSERT(xylem_ringbuf_empty(ring));
+    ASSERT(xylem_ringbuf_read(ring, out, 1) == 0);
+
+    xylem_ringbuf_destroy(ring);
+}
+
+/**
+ * Test xylem_ringbuf_read_fd/write_fd through a pipe, with both transfers
+ * split across the wrap point.
+ */
+static void test_ringbuf_fd(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create(1, 64);
+    char             in[64];
+    char             out[64];
+    int              fds[2];
+
+    for (int i = 0; i < 64; i++) {
+        in[i] = (char)('a' + i % 26);
+    }
+    ASSERT(pipe(fds) == 0);
+
+    /* move the positions so that the free space wraps. */
+    ASSERT(xylem_ringbuf_write(ring, in, 40) == 40);
+    ASSERT(xylem_ringbuf_read(ring, out, 40) == 40);
+
+    ASSERT(write(fds[1], in, 64) == 64);
+    ASSERT(xylem_ringbuf_read_fd(ring, fds[0]) == 64);
+    ASSERT(xylem_ringbuf_full(ring));
+    ASSERT(xylem_ringbuf_read_fd(ring, fds[0]) == 0);
+
+    ASSERT(xylem_ringbuf_write_fd(ring, fds[1]) == 64);
+    ASSERT(xylem_ringbuf_empty(ring));
+    ASSERT(xylem_ringbuf_write_fd(ring, fds[1]) == 0);
+    ASSERT(read(fds[0], out, 64) == 64);
+    ASSERT(memcmp(out, in, 64) == 0);
+
+    close(fds[0]);
+    close(fds[1]);
+    xylem_ringbuf_destroy(ring);
+
+    ring = xylem_ringbuf_create(4, 64);
+    ASSERT(xylem_ringbuf_read_fd(ring, 0) == -1);
+    ASSERT(errno == EINVAL);
+    ASSERT(xylem_ringbuf_write_fd(ring, 1) == -1);
+    ASSERT(errno == EINVAL);
+    xylem_ringbuf_destroy(ring);
+}
+
+/**
+ * Test XYLEM_RINGBUF_OVERWRITE: a full ring keeps the newest entries and
+ * counts the ones it dropped.
+ */
+static void test_ringbuf_overwrite(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create_ex(
+        sizeof(uint32_t), 8 * sizeof(uint32_t), XYLEM_RINGBUF_OVERWRITE);
+    uint32_t in[20];
+    uint32_t out[20];
+
+    for (uint32_t i = 0; i < 20; i++) {
+        in[i] = i;
+    }
+    ASSERT(xylem_ringbuf_write(ring, in, 6) == 6);
+    ASSERT(xylem_ringbuf_dropped(ring) == 0);
+    ASSERT(xylem_ringbuf_write(ring, in + 6, 4) == 4);
+    ASSERT(xylem_ringbuf_dropped(ring) == 2);
+    ASSERT(xylem_ringbuf_full(ring));
+
+    ASSERT(xylem_ringbuf_snapshot(ring, out, 3) == 3);
+    ASSERT(out[0] == 7 && out[1] == 8 && out[2] == 9);
+    ASSERT(xylem_ringbuf_len(ring) == 8);
+
+    ASSERT(xylem_ringbuf_read(ring, out, 2) == 2);
+    ASSERT(out[0] == 2 && out[1] == 3);
+
+    /* a write larger than the ring only keeps its tail. */
+    ASSERT(xylem_ringbuf_write(ring, in, 20) == 20);
+    ASSERT(xylem_ringbuf_dropped(ring) == 2 + 6 + 12);
+    ASSERT(xylem_ringbuf_read(ring, out, 20) == 8);
+    ASSERT(memcmp(out, in + 12, 8 * sizeof(uint32_t)) == 0);
+    ASSERT(xylem_ringbuf_empty(ring));
+    ASSERT(xylem_ringbuf_snapshot(ring, out, 20) == 0);
+
+    xylem_ringbuf_destroy(ring);
+}
+
+#define OVERWRITE_TOTAL 200000
+
+static atomic_bool overwrite_done;
+
+static int _overwrite_writer(void* arg) {
+    xylem_ringbuf_t* ring = arg;
+    for (uint64_t i = 1; i <= OVERWRITE_TOTAL; i++) {
+        xylem_ringbuf_write(ring, &i, 1);
+    }
+    atomic_store(&overwrite_done, true);
+    return 0;
+}
+
+static int _overwrite_reader(void* arg) {
+    xylem_ringbuf_t* ring = arg;
+    uint64_t         last = 0;
+    uint64_t         batch[64];
+
+    for (;;) {
+        bool   done = atomic_load(&overwrite_done);
+        size_t n = xylem_ringbuf_read(ring, batch, 64);
+        ASSERT(n <= xylem_ringbuf_cap(ring));
+        for (size_t i = 0; i < n; i++) {
+            ASSERT(batch[i] > last);
+            ASSERT(batch[i] <= OVERWRITE_TOTAL);
+            last = batch[i];
+        }
+        if (n == 0) {
+            if (done) {
+                break;
+            }
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static int _overwrite_snapshotter(void* arg) {
+    xylem_ringbuf_t* ring = arg;
+    uint64_t         batch[64];
+
+    while (!atomic_load(&overwrite_done)) {
+        size_t n = xylem_ringbuf_snapshot(ring, batch, 64);
+        ASSERT(n <= xylem_ringbuf_cap(ring));
+        for (size_t i = 1; i < n; i++) {
+            ASSERT(batch[i] == batch[i - 1] + 1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Test XYLEM_RINGBUF_OVERWRITE with one writer, two consuming readers and
+ * a snapshot reader running concurrently: every reader sees increasing
+ * values and snapshots are always contiguous. With `cap` below the readers'
+ * 64-entry buffers, lapped readers must not copy more than the ring holds.
+ */
+static void test_ringbuf_overwrite_concurrent(size_t cap) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create_ex(
+        sizeof(uint64_t), cap * sizeof(uint64_t), XYLEM_RINGBUF_OVERWRITE);
+    thrd_t writer, readers[2], snapshotter;
+
+    atomic_store(&overwrite_done, false);
+    ASSERT(thrd_create(&readers[0], _overwrite_reader, ring) == thrd_success);
+    ASSERT(thrd_create(&readers[1], _overwrite_reader, ring) == thrd_success);
+    ASSERT(
+        thrd_create(&snapshotter, _overwrite_snapshotter, ring) ==
+        thrd_success);
+    ASSERT(thrd_create(&writer, _overwrite_writer, ring) == thrd_success);
+
+    thrd_join(writer, NULL);
+    thrd_join(readers[0], NULL);
+    thrd_join(readers[1], NULL);
+    thrd_join(snapshotter, NULL);
+    ASSERT(xylem_ringbuf_empty(ring));
+    xylem_ringbuf_destroy(ring);
+}
+
+/**
+ * Test that xylem_ringbuf_read_wait/write_wait give up after the timeout
+ * on an empty or full ring.
+ */
+static void test_ringbuf_wait_timeout(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create(1, 16);
+    char             buf[32] = {0};
+    struct timespec  t0, t1;
+
+    timespec_get(&t0, TIME_UTC);
+    ASSERT(xylem_ringbuf_read_wait(ring, buf, 1, 20) == 0);
+    timespec_get(&t1, TIME_UTC);
+    long elapsed_ms = (long)(t1.tv_sec - t0.tv_sec) * 1000 +
+                      (t1.tv_nsec - t0.tv_nsec) / 1000000;
+    ASSERT(elapsed_ms >= 15);
+
+    ASSERT(xylem_ringbuf_write_wait(ring, buf, 32, 10) == 16);
+    ASSERT(xylem_ringbuf_read_wait(ring, buf, 32, 0) == 16);
+    ASSERT(xylem_ringbuf_read_wait(ring, buf, 32, 0) == 0);
+
+    xylem_ringbuf_destroy(ring);
+}
+
+#define WAIT_TOTAL 100000
+
+static int _wait_producer(void* arg) {
+    xylem_ringbuf_t* ring = arg;
+    uint64_t         batch[7];
+
+    for (uint64_t i = 0; i < WAIT_TOTAL; i += 7) {
+        size_t n = (WAIT_TOTAL - i < 7) ? (size_t)(WAIT_TOTAL - i) : 7;
+        for (size_t j = 0; j < n; j++) {
+            batch[j] = i + j;
+        }
+        ASSERT(xylem_ringbuf_write_wait(ring, batch, n, -1) == n);
+    }
+    return 0;
+}
+
+/**
+ * Test a producer and a consumer thread that block on a small ring with
+ * xylem_ringbuf_write_wait/read_wait.
+ */
+static void test_ringbuf_wait_threads(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create_ex(
+        sizeof(uint64_t), 16 * sizeof(uint64_t), XYLEM_RINGBUF_BLOCKING);
+    uint64_t batch[5];
+    uint64_t expect = 0;
+    thrd_t   producer;
+
+    ASSERT(thrd_create(&producer, _wait_producer, ring) == thrd_success);
+    while (expect < WAIT_TOTAL) {
+        size_t n = xylem_ringbuf_read_wait(ring, batch, 5, -1);
+        ASSERT(n > 0);
+        for (size_t i = 0; i < n; i++) {
+            ASSERT(batch[i] == expect++);
+        }
+    }
+    thrd_join(producer, NULL);
+    ASSERT(xylem_ringbuf_empty(ring));
+    xylem_ringbuf_destroy(ring);
+}
+
+static int _poll_producer(void* arg) {
+    uint64_t v = 42;
+
+    thrd_sleep(&(struct timespec){.tv_nsec = 5000000}, NULL);
+    ASSERT(xylem_ringbuf_write(arg, &v, 1) == 1);
+    return 0;
+}
+
+/**
+ * Test that waits on a ring without XYLEM_RINGBUF_BLOCKING, whose writers
+ * never wake anyone, still notice new entries by polling.
+ */
+static void test_ringbuf_wait_poll(void) {
+    xylem_ringbuf_t* ring =
+        xylem_ringbuf_create(sizeof(uint64_t), 16 * sizeof(uint64_t));
+    uint64_t v = 0;
+    thrd_t   producer;
+
+    ASSERT(thrd_create(&producer, _poll_producer, ring) == thrd_success);
+    ASSERT(xylem_ringbuf_read_wait(ring, &v, 1, -1) == 1);
+    ASSERT(v == 42);
+    thrd_join(producer, NULL);
+    xylem_ringbuf_destroy(ring);
+}
+
+/**
+ * Test a ring generated by XYLEM_RINGBUF_DEFINE: push/pop, batch transfer
+ * across the wrap point, and the full/empty limits.
+ */
+static void test_ringbuf_define(void) {
+    test_ring_t ring;
+    test_pair_t in[8];
+    test_pair_t out[8];
+
+    for (uint32_t i = 0; i < 8; i++) {
+        in[i].a = i;
+        in[i].b = (uint16_t)(i * 3);
+    }
+    test_ring_init(&ring);
+    ASSERT(test_ring_cap(&ring) == 8);
+    ASSERT(test_ring_empty(&ring));
+    ASSERT(!test_ring_pop(&ring, &out[0]));
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT(test_ring_push(&ring, &in[i]));
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT(test_ring_pop(&ring, &out[0]));
+        ASSERT(out[0].a == in[i].a && out[0].b == in[i].b);
+    }
+    ASSERT(test_ring_write(&ring, in, 8) == 8);
+    ASSERT(test_ring_full(&ring));
+    ASSERT(!test_ring_push(&ring, &in[0]));
+    ASSERT(test_ring_write(&ring, in, 1) == 0);
+
+    ASSERT(test_ring_read(&ring, out, 3) == 3);
+    ASSERT(test_ring_len(&ring) == 5);
+    ASSERT(test_ring_read(&ring, out + 3, 8) == 5);
+    for (int i = 0; i < 8; i++) {
+        ASSERT(out[i].a == in[i].a && out[i].b == in[i].b);
+    }
+    ASSERT(test_ring_empty(&ring));
+}
+
+#define MPSC_PRODUCERS 4
+#define MPSC_PER_PRODUCER 20000
+
+typedef struct mpsc_arg_s {
+    xylem_ringbuf_t* ring;
+    uint32_t         id;
+} mpsc_arg_t;
+
+static int _mpsc_producer(void* arg) {
+    mpsc_arg_t* a = arg;
+
+    for (uint32_t i = 0; i < MPSC_PER_PRODUCER; i++) {
+        uint64_t v = ((uint64_t)a->id << 32) | i;
+        ASSERT(xylem_ringbuf_write_wait(a->ring, &v, 1, -1) == 1);
+    }
+    return 0;
+}
+
+/**
+ * Test XYLEM_RINGBUF_MPSC: several producer threads write concurrently and
+ * the reader sees every entry, in order per producer.
+ */
+static void test_ringbuf_mpsc(void) {
+    xylem_ringbuf_t* ring = xylem_ringbuf_create_ex(
+        sizeof(uint64_t),
+        64 * sizeof(uint64_t),
+        XYLEM_RINGBUF_MPSC | XYLEM_RINGBUF_BLOCKING);
+    mpsc_arg_t args[MPSC_PRODUCERS];
+    thrd_t     thrds[MPSC_PRODUCERS];
+    uint32_t   next[MPSC_PRODUCERS] = {0};
+    uint64_t   batch[16];
+
+    ASSERT(xylem_ringbuf_create_ex(
+               1, 64, XYLEM_RINGBUF_MPSC | XYLEM_RINGBUF_OVERWRITE) == NULL);
+
+    for (uint32_t i = 0; i < MPSC_PRODUCERS; i++) {
+        args[i].ring = ring;
+        args[i].id = i;
+        int ret = thrd_create(&thrds[i], _mpsc_producer, &args[i]);
+        ASSERT(ret == thrd_success);
+    }
+    for (size_t got = 0; got < MPSC_PRODUCERS * MPSC_PER_PRODUCER;) {
+        size_t n = xylem_ringbuf_read_wait(ring, batch, 16, -1);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t id = (uint32_t)(batch[i] >> 32);
+            ASSERT(id < MPSC_PRODUCERS);
+            ASSERT((uint32_t)batch[i] == next[id]++);
+        }
+        got += n;
+    }
+    for (uint32_t i = 0; i < MPSC_PRODUCERS; i++) {
+        thrd_join(thrds[i], NULL);
+    }
+    ASSERT(xylem_ringbuf_empty(ring));
+    xylem_ringbuf_destroy(ring);
+}
+
+/**
+ * Test a process-shared ring: a second handle attached by name sees the
+ * same positions and data, and names cannot be created twice.
+ */
+static void test_ringbuf_shared(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "/xylem-test-%u", (unsigned)time(NULL));
+
+    xylem_ringbuf_t* a = xylem_ringbuf_create_shared(
+        name, sizeof(uint32_t), 16 * sizeof(uint32_t), 0);
+    ASSERT(a != NULL);
+    ASSERT(xylem_ringbuf_create_shared(name, 1, 16, 0) == NULL);
+
+    xylem_ringbuf_t* b = xylem_ringbuf_open_shared(name);
+    ASSERT(b != NULL);
+    ASSERT(xylem_ringbuf_cap(b) == 16);
+
+    uint32_t in[20];
+    uint32_t out[20];
+    for (uint32_t i = 0; i < 20; i++) {
+        in[i] = i * 7;
+    }
+    ASSERT(xylem_ringbuf_write(a, in, 20) == 16);
+    ASSERT(xylem_ringbuf_full(b));
+    ASSERT(xylem_ringbuf_read(b, out, 20) == 16);
+    ASSERT(memcmp(in, out, 16 * sizeof(uint32_t)) == 0);
+    ASSERT(xylem_ringbuf_empty(a));
+
+    xylem_ringbuf_destroy(b);
+    xylem_ringbuf_destroy(a);
+    ASSERT(xylem_ringbuf_open_shared(name) == NULL);
+}
+
+#if !defined(_WIN32)
+#define SHARED_TOTAL 50000
+
+/**
+ * Test a process-shared ring between a parent and a forked child that
+ * attaches by name, with both sides blocking on the shared futexes.
+ */
+static void test_ringbuf_shared_process(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "/xylem-test-proc-%u", (unsigned)time(NULL));
+
+    xylem_ringbuf_t* ring = xylem_ringbuf_create_shared(
+        name,
+        sizeof(uint64_t),
+        32 * sizeof(uint64_t),
+        XYLEM_RINGBUF_MPSC | XYLEM_RINGBUF_BLOCKING);
+    ASSERT(ring != NULL);
+
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (pid == 0) {
+        xylem_ringbuf_t* child = xylem_ringbuf_open_shared(name);
+        if (!child) {
+            _exit(1);
+        }
+        for (uint64_t i = 0; i < SHARED_TOTAL; i++) {
+            if (xylem_ringbuf_write_wait(child, &i, 1, 5000) != 1) {
+                _exit(2);
+            }
+        }
+        xylem_ringbuf_destroy(child);
+        _exit(0);
+    }
+    for (uint64_t expect = 0; expect < SHARED_TOTAL;) {
+        uint64_t batch[8];
+        size_t   n = xylem_ringbuf_read_wait(ring, batch, 8, 5000);
+        ASSERT(n > 0);
+        for (size_t i = 0; i < n; i++) {
+            ASSERT(batch[i] == expect++);
+        }
+    }
+    int status = 0;
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    xylem_ringbuf_destroy(ring);
+}
+#endif
+
+int main(void) {
+    test_ringbuf_create();
+    test_ringbuf_write_read();
+    test_ringbuf_fd();
+    test_ringbuf_overwrite();
+    test_ringbuf_overwrite_concurrent(256);
+    test_ringbuf_overwrite_concurrent(8);
+    test_ringbuf_wait_timeout();
+    test_ringbuf_wait_threads();
+    test_ringbuf_wait_poll();
+    test_ringbuf_define();
+    test_ringbuf_mpsc();
+    test_ringbuf_shared();
+#if !defined(_WIN32)
+    test_ringbuf_shared_process();
+#endif
+    return 0;
+}
\ No newline at end of file
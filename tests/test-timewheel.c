@@ -0,0 +1,163 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+#define NTIMERS 3000
+
+typedef struct test_timer_s {
+    xylem_timewheel_node_t node;
+    uint64_t               expire;
+    int                    fired;
+} test_timer_t;
+
+typedef struct test_window_s {
+    uint64_t lo;
+    uint64_t hi;
+} test_window_t;
+
+static test_timer_t timers[NTIMERS];
+
+static uint64_t _rand(uint64_t* seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 33;
+}
+
+/* every timer must fire in the first advance that reaches its expiry. */
+static void _check_window(xylem_timewheel_node_t* node, void* arg) {
+    test_window_t* w = arg;
+    test_timer_t*  t = xylem_timewheel_entry(node, test_timer_t, node);
+
+    ASSERT(!xylem_timewheel_pending(node));
+    ASSERT(t->expire <= w->hi);
+    ASSERT(t->expire > w->lo);
+    t->fired++;
+}
+
+/**
+ * Test xylem_timewheel_add and advance: timers spread over every level and
+ * the overflow heap fire exactly once, in the advance covering their expiry.
+ */
+static void test_timewheel_expire(void) {
+    xylem_timewheel_t wheel;
+    test_window_t     w;
+    uint64_t          seed = 1;
+    uint64_t          now = 1000;
+    size_t            total = 0;
+
+    xylem_timewheel_init(&wheel, now);
+    ASSERT(xylem_timewheel_empty(&wheel));
+
+    for (int i = 0; i < NTIMERS; i++) {
+        uint64_t range[] = {60, 4000, 250000, 16000000, 100000000};
+        xylem_timewheel_node_init(&timers[i].node);
+        timers[i].expire = now + 1 + _rand(&seed) % range[i % 5];
+        timers[i].fired = 0;
+        xylem_timewheel_add(&wheel, &timers[i].node, timers[i].expire);
+        ASSERT(xylem_timewheel_pending(&timers[i].node));
+    }
+    ASSERT(wheel.nelts == NTIMERS);
+
+    while (!xylem_timewheel_empty(&wheel)) {
+        w.lo = now;
+        now += 1 + _rand(&seed) % ((seed & 1) ? 50 : 200000);
+        w.hi = now;
+        total += xylem_timewheel_advance(&wheel, now, _check_window, &w);
+    }
+    ASSERT(total == NTIMERS);
+    for (int i = 0; i < NTIMERS; i++) {
+        ASSERT(timers[i].fired == 1);
+    }
+}
+
+/**
+ * Test xylem_timewheel_cancel and reset: cancelled timers never fire and
+ * reset timers fire at their new expiry only.
+ */
+static void test_timewheel_cancel_reset(void) {
+    xylem_timewheel_t wheel;
+    test_window_t     w = {0, 0};
+
+    xylem_timewheel_init(&wheel, 0);
+    for (int i = 0; i < 100; i++) {
+        xylem_timewheel_node_init(&timers[i].node);
+        timers[i].expire = 10 + i * 100;
+        timers[i].fired = 0;
+        xylem_timewheel_add(&wheel, &timers[i].node, timers[i].expire);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        xylem_timewheel_cancel(&wheel, &timers[i].node);
+        ASSERT(!xylem_timewheel_pending(&timers[i].node));
+    }
+    xylem_timewheel_cancel(&wheel, &timers[0].node);
+    for (int i = 1; i < 100; i += 4) {
+        timers[i].expire = 50000000 + i;
+        xylem_timewheel_reset(&wheel, &timers[i].node, timers[i].expire);
+    }
+    ASSERT(wheel.nelts == 50);
+
+    w.hi = 20000;
+    ASSERT(xylem_timewheel_advance(&wheel, w.hi, _check_window, &w) == 25);
+    for (int i = 0; i < 100; i++) {
+        ASSERT(timers[i].fired == (i % 4 == 3));
+    }
+    w.lo = w.hi;
+    w.hi = 60000000;
+    ASSERT(xylem_timewheel_advance(&wheel, w.hi, _check_window, &w) == 25);
+    ASSERT(xylem_timewheel_empty(&wheel));
+}
+
+static void _rearm(xylem_timewheel_node_t* node, void* arg) {
+    xylem_timewheel_t* wheel = arg;
+    test_timer_t*      t = xylem_timewheel_entry(node, test_timer_t, node);
+
+    t->fired++;
+    if (t->fired < 5) {
+        /* an expiry in the past fires on the next advance, not this one. */
+        xylem_timewheel_add(wheel, node, 0);
+    }
+}
+
+/**
+ * Test re-arming from the callback and adding timers that are already due.
+ */
+static void test_timewheel_rearm(void) {
+    xylem_timewheel_t wheel;
+
+    xylem_timewheel_init(&wheel, 500);
+    xylem_timewheel_node_init(&timers[0].node);
+    timers[0].fired = 0;
+    xylem_timewheel_add(&wheel, &timers[0].node, 100);
+
+    for (uint64_t now = 501; now < 510; now++) {
+        xylem_timewheel_advance(&wheel, now, _rearm, &wheel);
+        ASSERT(timers[0].fired == (int)(now - 500 < 5 ? now - 500 : 5));
+    }
+    ASSERT(xylem_timewheel_empty(&wheel));
+}
+
+int main(void) {
+    test_timewheel_expire();
+    test_timewheel_cancel_reset();
+    test_timewheel_rearm();
+    return 0;
+}
\ No newline at end of file
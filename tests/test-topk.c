@@ -0,0 +1,96 @@
+/** Copyright (c) 2026-2036, Jin.Wu <wujin.developer@gmail.com>
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#include "xylem.h"
+#include "assert.h"
+
+static int _cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static int _cmp_u32_desc(const void* a, const void* b) {
+    return _cmp_u32(b, a);
+}
+
+/**
+ * Test xylem_topk over a stream: the kept set equals the k largest of a
+ * full sort, and the threshold rejects everything below it.
+ */
+static void test_topk_stream(void) {
+    static uint32_t stream[10000];
+    uint32_t        out[100];
+    uint64_t        seed = 5;
+
+    xylem_topk_t* topk = xylem_topk_create(100, sizeof(uint32_t), _cmp_u32);
+    ASSERT(topk != NULL);
+    ASSERT(xylem_topk_threshold(topk) == NULL);
+
+    for (size_t i = 0; i < 10000; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        stream[i] = (uint32_t)(seed >> 40);
+        const uint32_t* bar = xylem_topk_threshold(topk);
+        uint32_t        min = bar ? *bar : 0;
+        bool            kept = xylem_topk_push(topk, &stream[i]);
+        ASSERT(kept == (!bar || stream[i] > min));
+    }
+    ASSERT(xylem_topk_len(topk) == 100);
+    ASSERT(xylem_topk_sorted(topk, out) == 100);
+
+    qsort(stream, 10000, sizeof(uint32_t), _cmp_u32_desc);
+    ASSERT(memcmp(out, stream, sizeof(out)) == 0);
+    ASSERT(*(const uint32_t*)xylem_topk_threshold(topk) == stream[99]);
+
+    /* sorting leaves the selector intact. */
+    ASSERT(xylem_topk_sorted(topk, out) == 100);
+    ASSERT(memcmp(out, stream, sizeof(out)) == 0);
+
+    xylem_topk_reset(topk);
+    ASSERT(xylem_topk_len(topk) == 0);
+    xylem_topk_destroy(topk);
+}
+
+/**
+ * Test a stream shorter than k: everything is kept and returned sorted.
+ */
+static void test_topk_partial(void) {
+    uint32_t in[] = {5, 1, 9, 3, 9, 7};
+    uint32_t out[6];
+    uint32_t expect[] = {9, 9, 7, 5, 3, 1};
+
+    xylem_topk_t* topk = xylem_topk_create(10, sizeof(uint32_t), _cmp_u32);
+    for (size_t i = 0; i < 6; i++) {
+        ASSERT(xylem_topk_push(topk, &in[i]));
+    }
+    ASSERT(xylem_topk_threshold(topk) == NULL);
+    ASSERT(xylem_topk_sorted(topk, out) == 6);
+    ASSERT(memcmp(out, expect, sizeof(out)) == 0);
+    xylem_topk_destroy(topk);
+
+    ASSERT(xylem_topk_create(0, sizeof(uint32_t), _cmp_u32) == NULL);
+}
+
+int main(void) {
+    test_topk_stream();
+    test_topk_partial();
+    return 0;
+}
\ No newline at end of file